@@ -86,6 +86,110 @@ inline uint8_t *pgm_read_bitmap_ptr(const GFXfont *gfxFont) {
 #endif //__AVR__
 }
 
+inline GFXkern *pgm_read_kern_ptr(const GFXfont2 *ext) {
+#ifdef __AVR__
+  return (GFXkern *)pgm_read_pointer(&ext->kern);
+#else
+  return ext->kern;
+#endif //__AVR__
+}
+
+// ext is the GFXfont2 wrapping gfxFont, or NULL for a version 1 font
+inline uint32_t pgm_read_bitmap_offset(const GFXfont *gfxFont,
+                                       const GFXfont2 *ext, uint8_t c) {
+  if (ext) {
+#ifdef __AVR__
+    uint32_t *offset = (uint32_t *)pgm_read_pointer(&ext->offset);
+    if (offset)
+      return pgm_read_dword(&offset[c]);
+#else
+    if (ext->offset) // 32-bit offsets (v2)
+      return ext->offset[c];
+#endif //__AVR__
+  }
+  return pgm_read_word(&pgm_read_glyph_ptr(gfxFont, c)->bitmapOffset);
+}
+
+// Reads a custom font glyph's pixels in order (left to right, top to
+// bottom), from either a plain bit-packed or an RLE-compressed bitmap.
+typedef struct {
+  uint8_t *bitmap; // Start of glyph's bitmap
+  uint16_t i;      // Index of next bit (plain) or nibble (RLE) to read
+  uint8_t bits;    // Plain: current byte, next bit in MSB. RLE: current byte
+  uint8_t run;     // RLE: pixels left in current run
+  bool set;        // RLE: current run is of set pixels
+  bool rle;        // Bitmap is RLE-compressed
+} GFXglyphBits;
+
+static void glyphBitsBegin(GFXglyphBits *g, const GFXfont *gfxFont,
+                           const GFXfont2 *ext, uint8_t c) {
+  g->bitmap =
+      pgm_read_bitmap_ptr(gfxFont) + pgm_read_bitmap_offset(gfxFont, ext, c);
+  g->i = 0;
+  g->bits = 0;
+  g->run = 0;
+  g->set = true; // 1st run is clear
+  g->rle = ext && (pgm_read_byte(&ext->flags) & GFXFONT_RLE);
+}
+
+static inline void glyphBitsRun(GFXglyphBits *g) {
+  while (!g->run) { // Next nonzero run, colors alternate
+    if (!(g->i & 1))
+      g->bits = pgm_read_byte(&g->bitmap[g->i >> 1]);
+    g->run = (g->i++ & 1) ? (g->bits & 0x0F) : (g->bits >> 4);
+    g->set = !g->set;
+  }
+}
+
+static inline bool glyphBitsNext(GFXglyphBits *g) {
+  if (g->rle) {
+    glyphBitsRun(g);
+    g->run--;
+    return g->set;
+  }
+  if (!(g->i++ & 7))
+    g->bits = pgm_read_byte(&g->bitmap[(g->i - 1) >> 3]);
+  bool set = g->bits & 0x80;
+  g->bits <<= 1;
+  return set;
+}
+
+static void glyphBitsSkip(GFXglyphBits *g, uint16_t n) {
+  if (g->rle) {
+    while (n) {
+      glyphBitsRun(g);
+      uint8_t k = (n < g->run) ? n : g->run;
+      g->run -= k;
+      n -= k;
+    }
+  } else if (n) {
+    g->i += n;
+    if (g->i & 7) // Mid-byte, preload it
+      g->bits = pgm_read_byte(&g->bitmap[g->i >> 3]) << (g->i & 7);
+  }
+}
+
+// Kerning adjustment for a pair of chars in a custom font, in font pixels
+static int8_t kernPair(const GFXfont2 *ext, uint8_t left, uint8_t right) {
+  GFXkern *kern = ext ? pgm_read_kern_ptr(ext) : NULL;
+  if (!kern)
+    return 0;
+  uint16_t lo = 0, hi = pgm_read_word(&ext->kernCount);
+  uint16_t key = ((uint16_t)left << 8) | right;
+  while (lo < hi) { // Binary search of sorted pairs
+    uint16_t mid = lo + (hi - lo) / 2;
+    uint16_t k = ((uint16_t)pgm_read_byte(&kern[mid].left) << 8) |
+                 pgm_read_byte(&kern[mid].right);
+    if (k == key)
+      return (int8_t)pgm_read_byte(&kern[mid].dx);
+    if (k < key)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return 0;
+}
+
 #ifndef min
 #define min(a, b) (((a) < (b)) ? (a) : (b))
 #endif
@@ -112,13 +216,24 @@ Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h) {
   _height = HEIGHT;
   rotation = 0;
   cursor_y = cursor_x = 0;
+  prevChar = 0;
   textsize_x = textsize_y = 1;
   textcolor = textbgcolor = 0xFFFF;
   wrap = true;
   _cp437 = false;
   gfxFont = NULL;
+  gfxFont2 = NULL;
+  glyphCache = NULL;
+  resetClipRect();
 }
 
+/**************************************************************************/
+/*!
+   @brief    Destructor, frees the glyph cache if one was set up
+*/
+/**************************************************************************/
+Adafruit_GFX::~Adafruit_GFX(void) { free(glyphCache); }
+
 /**************************************************************************/
 /*!
    @brief    Write a line.  Bresenham's algorithm - thx wikpedia
@@ -188,7 +303,8 @@ void Adafruit_GFX::startWrite() {}
 */
 /**************************************************************************/
 void Adafruit_GFX::writePixel(int16_t x, int16_t y, uint16_t color) {
-  drawPixel(x, y, color);
+  if (inClip(x, y))
+    drawPixel(x, y, color);
 }
 
 /**************************************************************************/
@@ -206,6 +322,9 @@ void Adafruit_GFX::writeFastVLine(int16_t x, int16_t y, int16_t h,
   // Overwrite in subclasses if startWrite is defined!
   // Can be just writeLine(x, y, x, y+h-1, color);
   // or writeFillRect(x, y, 1, h, color);
+  int16_t w = 1;
+  if (_clipActive && !clipRect(x, y, w, h))
+    return;
   drawFastVLine(x, y, h, color);
 }
 
@@ -224,6 +343,9 @@ void Adafruit_GFX::writeFastHLine(int16_t x, int16_t y, int16_t w,
   // Overwrite in subclasses if startWrite is defined!
   // Example: writeLine(x, y, x+w-1, y, color);
   // or writeFillRect(x, y, w, 1, color);
+  int16_t h = 1;
+  if (_clipActive && !clipRect(x, y, w, h))
+    return;
   drawFastHLine(x, y, w, color);
 }
 
@@ -241,6 +363,8 @@ void Adafruit_GFX::writeFastHLine(int16_t x, int16_t y, int16_t w,
 void Adafruit_GFX::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
                                  uint16_t color) {
   // Overwrite in subclasses if desired!
+  if (_clipActive && !clipRect(x, y, w, h))
+    return;
   fillRect(x, y, w, h, color);
 }
 
@@ -330,19 +454,19 @@ void Adafruit_GFX::fillScreen(uint16_t color) {
 void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
                             uint16_t color) {
   // Update in subclasses if desired!
+  startWrite();
   if (x0 == x1) {
     if (y0 > y1)
       _swap_int16_t(y0, y1);
-    drawFastVLine(x0, y0, y1 - y0 + 1, color);
+    writeFastVLine(x0, y0, y1 - y0 + 1, color);
   } else if (y0 == y1) {
     if (x0 > x1)
       _swap_int16_t(x0, x1);
-    drawFastHLine(x0, y0, x1 - x0 + 1, color);
+    writeFastHLine(x0, y0, x1 - x0 + 1, color);
   } else {
-    startWrite();
     writeLine(x0, y0, x1, y1, color);
-    endWrite();
   }
+  endWrite();
 }
 
 /**************************************************************************/
@@ -435,8 +559,8 @@ void Adafruit_GFX::fillEllipse(int16_t x0, int16_t y0, int16_t rw, int16_t rh,
       decision += rh2 + (twoRh2 * x);
     } else {
       decision += rh2 + (twoRh2 * x) - (twoRw2 * y);
-      drawFastHLine(x0 - (x - 1), y0 + y, 2 * (x - 1) + 1, color);
-      drawFastHLine(x0 - (x - 1), y0 - y, 2 * (x - 1) + 1, color);
+      writeFastHLine(x0 - (x - 1), y0 + y, 2 * (x - 1) + 1, color);
+      writeFastHLine(x0 - (x - 1), y0 - y, 2 * (x - 1) + 1, color);
       y--;
     }
   }
@@ -445,8 +569,8 @@ void Adafruit_GFX::fillEllipse(int16_t x0, int16_t y0, int16_t rw, int16_t rh,
   decision = ((rh2 * (2 * x + 1) * (2 * x + 1)) >> 2) +
              (rw2 * (y - 1) * (y - 1)) - (rw2 * rh2);
   while (y >= 0) {
-    drawFastHLine(x0 - x, y0 + y, 2 * x + 1, color);
-    drawFastHLine(x0 - x, y0 - y, 2 * x + 1, color);
+    writeFastHLine(x0 - x, y0 + y, 2 * x + 1, color);
+    writeFastHLine(x0 - x, y0 - y, 2 * x + 1, color);
 
     y--;
     if (decision > 0) {
@@ -731,34 +855,20 @@ void Adafruit_GFX::drawRotatedRect(int16_t cenX, int16_t cenY, int16_t w,
   int16_t halfW = (W / 2); // Midpoint should always be integer
   int16_t halfH = (H / 2); // Midpoint should always be integer
 
-  int16_t x0 = W - halfW; // bottom-right
-  int16_t y0 = H - halfH; // bottom-right
-  int16_t x1 = -halfW;    // bottom-left
-  int16_t y1 = H - halfH; // bottom-left
-  int16_t x2 = -halfW;    // top-left
-  int16_t y2 = -halfH;    // top-left
-  int16_t x3 = W - halfW; // top-right
-  int16_t y3 = -halfH;    // top-right
-
-  rotatePoint(x0, y0, angleDeg);
-  rotatePoint(x1, y1, angleDeg);
-  rotatePoint(x2, y2, angleDeg);
-  rotatePoint(x3, y3, angleDeg);
+  // Corners: bottom-right, bottom-left, top-left, top-right
+  int16_t x[] = {(int16_t)(W - halfW), (int16_t)-halfW, (int16_t)-halfW,
+                 (int16_t)(W - halfW)};
+  int16_t y[] = {(int16_t)(H - halfH), (int16_t)(H - halfH), (int16_t)-halfH,
+                 (int16_t)-halfH};
 
-  x0 += cenX;
-  x1 += cenX;
-  x2 += cenX;
-  x3 += cenX;
+  rotatePoints(x, y, 4, angleDeg);
 
-  y0 += cenY;
-  y1 += cenY;
-  y2 += cenY;
-  y3 += cenY;
+  for (uint8_t i = 0; i < 4; i++) {
+    x[i] += cenX;
+    y[i] += cenY;
+  }
 
-  drawLine(x0, y0, x1, y1, color); // bottom right to bottom left
-  drawLine(x1, y1, x2, y2, color); // bottom left to top left
-  drawLine(x2, y2, x3, y3, color); // top left to top right
-  drawLine(x3, y3, x0, y0, color); // top right to bottom right
+  drawPolygon(x, y, 4, color);
 }
 
 /**************************************************************************/
@@ -791,32 +901,50 @@ void Adafruit_GFX::fillRotatedRect(int16_t cenX, int16_t cenY, int16_t w,
   int16_t halfW = (W / 2); // Midpoint should always be integer
   int16_t halfH = (H / 2); // Midpoint should always be integer
 
-  int16_t x0 = W - halfW; // bottom-right
-  int16_t y0 = H - halfH; // bottom-right
-  int16_t x1 = -halfW;    // bottom-left
-  int16_t y1 = H - halfH; // bottom-left
-  int16_t x2 = -halfW;    // top-left
-  int16_t y2 = -halfH;    // top-left
-  int16_t x3 = W - halfW; // top-right
-  int16_t y3 = -halfH;    // top-right
+  // Corners: bottom-right, bottom-left, top-left, top-right
+  int16_t x[] = {(int16_t)(W - halfW), (int16_t)-halfW, (int16_t)-halfW,
+                 (int16_t)(W - halfW)};
+  int16_t y[] = {(int16_t)(H - halfH), (int16_t)(H - halfH), (int16_t)-halfH,
+                 (int16_t)-halfH};
 
-  rotatePoint(x0, y0, angleDeg);
-  rotatePoint(x1, y1, angleDeg);
-  rotatePoint(x2, y2, angleDeg);
-  rotatePoint(x3, y3, angleDeg);
+  rotatePoints(x, y, 4, angleDeg);
 
-  x0 += cenX;
-  x1 += cenX;
-  x2 += cenX;
-  x3 += cenX;
+  for (uint8_t i = 0; i < 4; i++) {
+    x[i] += cenX;
+    y[i] += cenY;
+  }
 
-  y0 += cenY;
-  y1 += cenY;
-  y2 += cenY;
-  y3 += cenY;
+  // Filled as one shape rather than two triangles, so pixels along the
+  // diagonal aren't drawn twice
+  fillPolygon(x, y, 4, color);
+}
 
-  fillTriangle(x0, y0, x1, y1, x2, y2, color);
-  fillTriangle(x2, y2, x3, y3, x0, y0, color);
+// Quarter-wave sine table, one entry per degree from 0 to 90, scaled by
+// 32768 (Q15, with 90 degrees stored as 32768 so it's exact). Replaces
+// float sin()/cos(), which are very slow on chips without an FPU.
+static const uint16_t sinTableQ15[] PROGMEM = {
+    0, 572, 1144, 1715, 2286, 2856, 3425, 3993, 4560, 5126, 5690, 6252, 6813,
+    7371, 7927, 8481, 9032, 9580, 10126, 10668, 11207, 11743, 12275, 12803,
+    13328, 13848, 14365, 14876, 15384, 15886, 16384, 16877, 17364, 17847, 18324,
+    18795, 19261, 19720, 20174, 20622, 21063, 21498, 21926, 22348, 22763, 23170,
+    23571, 23965, 24351, 24730, 25102, 25466, 25822, 26170, 26510, 26842, 27166,
+    27482, 27789, 28088, 28378, 28660, 28932, 29197, 29452, 29698, 29935, 30163,
+    30382, 30592, 30792, 30983, 31164, 31336, 31499, 31651, 31795, 31928, 32052,
+    32166, 32270, 32365, 32449, 32524, 32588, 32643, 32688, 32723, 32748, 32763,
+    32768};
+
+// Sine of an angle in whole degrees (any range), Q15 (-32768 to +32768)
+static int32_t sinQ15(int16_t angleDeg) {
+  int16_t a = angleDeg % 360;
+  if (a < 0)
+    a += 360;
+  if (a <= 90)
+    return pgm_read_word(&sinTableQ15[a]);
+  if (a <= 180)
+    return pgm_read_word(&sinTableQ15[180 - a]);
+  if (a <= 270)
+    return -(int32_t)pgm_read_word(&sinTableQ15[a - 180]);
+  return -(int32_t)pgm_read_word(&sinTableQ15[360 - a]);
 }
 
 /**************************************************************************/
@@ -830,16 +958,34 @@ void Adafruit_GFX::fillRotatedRect(int16_t cenX, int16_t cenY, int16_t w,
 */
 /**************************************************************************/
 void Adafruit_GFX::rotatePoint(int16_t &x0, int16_t &y0, int16_t angleDeg) {
-  float angleRad = radians(angleDeg);
-  float s = sin(angleRad);
-  float c = cos(angleRad);
-
-  float x = x0;
-  float y = y0;
+  rotatePoints(&x0, &y0, 1, angleDeg);
+}
 
-  // Rotate point
-  x0 = (int16_t)((x * c) - (y * s));
-  y0 = (int16_t)((x * s) + (y * c));
+/**************************************************************************/
+/*!
+   @brief     Rotate a list of points in standard position. Sine and cosine
+              are looked up once for the whole list, and the math is all
+              integer, so this is much quicker than rotating points one at a
+              time where there's no FPU. Results are truncated toward zero.
+    @param    x  Array of x coordinates, updated in place
+    @param    y  Array of y coordinates, updated in place
+    @param    n  Number of points
+    @param    angleDeg  angle to rotate the points by (degrees)
+*/
+/**************************************************************************/
+void Adafruit_GFX::rotatePoints(int16_t x[], int16_t y[], uint16_t n,
+                                int16_t angleDeg) {
+  angleDeg %= 360; // So the cosine offset below can't overflow
+  int32_t s = sinQ15(angleDeg);
+  int32_t c = sinQ15(angleDeg + 90);
+
+  for (uint16_t i = 0; i < n; i++) {
+    // Each product is under 2^30, so the sum or difference fits in 32 bits
+    int32_t xr = (int32_t)x[i] * c - (int32_t)y[i] * s;
+    int32_t yr = (int32_t)x[i] * s + (int32_t)y[i] * c;
+    x[i] = (int16_t)(xr / 32768);
+    y[i] = (int16_t)(yr / 32768);
+  }
 }
 
 /**************************************************************************/
@@ -861,6 +1007,81 @@ void Adafruit_GFX::drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
   drawLine(x2, y2, x0, y0, color);
 }
 
+// Scanline edge walker for the filled-shape functions. Steps down an edge
+// one row at a time from its top vertex (x0,y0), producing the same x as
+// x0 + (x1 - x0) * (y - y0) / (y1 - y0) with C's truncating division, but
+// with only adds and compares per row (a couple of divides per edge total,
+// none per scanline -- these are costly on M0 and AVR). Edge MUST have
+// y1 > y0, i.e. horizontal edges are the caller's problem.
+struct GFXedge {
+  int16_t x;   // Current X crossing
+  int16_t xs;  // X step direction, +1 or -1
+  uint16_t q;  // Whole-pixel X step per row (magnitude)
+  uint16_t r;  // Remainder (fractional) X step per row
+  uint16_t f;  // Accumulated fraction, 0 to dy-1
+  uint16_t dy; // Edge height in rows (always > 0)
+
+  void init(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    uint16_t adx;
+    if (x1 >= x0) {
+      adx = x1 - x0;
+      xs = 1;
+    } else {
+      adx = x0 - x1;
+      xs = -1;
+    }
+    dy = y1 - y0;
+    q = adx / dy;
+    r = adx % dy;
+    x = x0;
+    f = 0;
+  }
+
+  // Skip ahead n rows (for clipping), one divide regardless of n
+  void seek(uint16_t n) {
+    uint32_t t = (uint32_t)r * n + f; // Total fraction across n rows
+    x += xs * (int16_t)(q * n + (uint16_t)(t / dy));
+    f = t % dy;
+  }
+
+  void step(void) {
+    x += xs * (int16_t)q;
+    if (f >= dy - r) { // Same as f + r >= dy, but can't overflow
+      f -= dy - r;
+      x += xs;
+    } else {
+      f += r;
+    }
+  }
+};
+
+/**************************************************************************/
+/*!
+   @brief    Horizontal span helper for the filled-shape functions, trims
+             the span to the display first so huge (off-screen) shapes
+             can't overflow the int16_t width passed to writeFastHLine().
+    @param    a  Left-most x coordinate (inclusive)
+    @param    b  Right-most x coordinate (inclusive), must be >= a
+    @param    y  Row y coordinate
+    @param    color 16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void Adafruit_GFX::writeSpan(int16_t a, int16_t b, int16_t y,
+                             uint16_t color) {
+  if (a < 0)
+    a = 0;
+  if (b >= _width)
+    b = _width - 1;
+  if (_clipActive) {
+    if (a < _clip.x0)
+      a = _clip.x0;
+    if (b > _clip.x1)
+      b = _clip.x1;
+  }
+  if (a <= b)
+    writeFastHLine(a, y, b - a + 1, color);
+}
+
 /**************************************************************************/
 /*!
    @brief     Draw a triangle with color-fill
@@ -892,6 +1113,14 @@ void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
     _swap_int16_t(x0, x1);
   }
 
+  // Rows above or below the display (or clip rectangle) are skipped
+  // without being walked
+  int16_t yEnd = y2;
+  y = y0;
+  clipRows(y, yEnd);
+  if (y > yEnd)
+    return; // Nothing visible, nothing to do
+
   startWrite();
   if (y0 == y2) { // Handle awkward all-on-same-line case as its own thing
     a = b = x0;
@@ -908,53 +1137,226 @@ void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
     return;
   }
 
-  int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0,
-          dx12 = x2 - x1, dy12 = y2 - y1;
-  int32_t sa = 0, sb = 0;
-
-  // For upper part of triangle, find scanline crossings for segments
-  // 0-1 and 0-2.  If y1=y2 (flat-bottomed triangle), the scanline y1
-  // is included here (and second loop will be skipped, avoiding a /0
-  // error there), otherwise scanline y1 is skipped here and handled
-  // in the second loop...which also avoids a /0 error here if y0=y1
-  // (flat-topped triangle).
+  // Long edge 0-2 spans all rows. Short edges 0-1 and 1-2 take the upper
+  // and lower parts of the triangle. If y1=y2 (flat-bottomed triangle),
+  // the scanline y1 is included in the upper part (and the lower part is
+  // skipped), otherwise scanline y1 goes with the lower part...which also
+  // covers the flat-topped y0=y1 case, where the upper part is empty.
   if (y1 == y2)
     last = y1; // Include y1 scanline
   else
     last = y1 - 1; // Skip it
 
-  for (y = y0; y <= last; y++) {
-    a = x0 + sa / dy01;
-    b = x0 + sb / dy02;
-    sa += dx01;
-    sb += dx02;
-    /* longhand:
-    a = x0 + (x1 - x0) * (y - y0) / (y1 - y0);
-    b = x0 + (x2 - x0) * (y - y0) / (y2 - y0);
-    */
-    if (a > b)
-      _swap_int16_t(a, b);
-    writeFastHLine(a, y, b - a + 1, color);
+  if (last > yEnd)
+    last = yEnd;
+
+  GFXedge e02, e;
+  e02.init(x0, y0, x2, y2);
+  e02.seek(y - y0);
+
+  if (y <= last) {
+    e.init(x0, y0, x1, y1);
+    e.seek(y - y0);
+    for (; y <= last; y++) {
+      a = e.x;
+      b = e02.x;
+      if (a > b)
+        _swap_int16_t(a, b);
+      writeSpan(a, b, y, color);
+      e.step();
+      e02.step();
+    }
   }
 
-  // For lower part of triangle, find scanline crossings for segments
-  // 0-2 and 1-2.  This loop is skipped if y1=y2.
-  sa = (int32_t)dx12 * (y - y1);
-  sb = (int32_t)dx02 * (y - y0);
-  for (; y <= y2; y++) {
-    a = x1 + sa / dy12;
-    b = x0 + sb / dy02;
-    sa += dx12;
-    sb += dx02;
-    /* longhand:
-    a = x1 + (x2 - x1) * (y - y1) / (y2 - y1);
-    b = x0 + (x2 - x0) * (y - y0) / (y2 - y0);
-    */
-    if (a > b)
-      _swap_int16_t(a, b);
-    writeFastHLine(a, y, b - a + 1, color);
+  if (y <= yEnd) {
+    e.init(x1, y1, x2, y2);
+    e.seek(y - y1);
+    for (; y <= yEnd; y++) {
+      a = e.x;
+      b = e02.x;
+      if (a > b)
+        _swap_int16_t(a, b);
+      writeSpan(a, b, y, color);
+      e.step();
+      e02.step();
+    }
+  }
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief     Draw a polygon outline, closing it back to the first vertex
+    @param    x  Array of vertex x coordinates
+    @param    y  Array of vertex y coordinates
+    @param    n  Number of vertices
+    @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawPolygon(const int16_t x[], const int16_t y[],
+                               uint16_t n, uint16_t color) {
+  for (uint16_t i = 0, j = n - 1; i < n; j = i++)
+    drawLine(x[j], y[j], x[i], y[i], color);
+}
+
+// Edge table entry for fillPolygon()
+struct GFXpolyEdge {
+  GFXedge e;  // X crossing stepper (for horizontal edges, e.x = left end)
+  int16_t y0; // Top row
+  int16_t y1; // Bottom row
+  int16_t x1; // X at bottom row (for horizontal edges, right end)
+};
+
+// Inclusive horizontal span, accumulated per scanline by fillPolygon()
+struct GFXspan {
+  int16_t x0, x1;
+};
+
+// Polygons with up to this many vertices are filled without malloc()
+#define GFX_POLYGON_STACK_EDGES 4
+
+/**************************************************************************/
+/*!
+   @brief     Draw a polygon with color-fill. Works with convex, concave
+              and self-intersecting shapes (using the even-odd rule: areas
+              enclosed an odd number of times are filled). Like
+              fillTriangle(), pixels along the outline are included, and
+              every pixel is written exactly once, so this is safe with
+              displays that have an XOR/INVERSE drawing mode. Polygons of
+              more than 4 vertices need a little temporary heap space
+              (about 30 bytes per vertex); if that can't be allocated,
+              nothing is drawn.
+    @param    x  Array of vertex x coordinates
+    @param    y  Array of vertex y coordinates
+    @param    n  Number of vertices
+    @param    color 16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void Adafruit_GFX::fillPolygon(const int16_t x[], const int16_t y[],
+                               uint16_t n, uint16_t color) {
+  GFXpolyEdge *stackActive[GFX_POLYGON_STACK_EDGES], **active = stackActive;
+  GFXpolyEdge stackEdges[GFX_POLYGON_STACK_EDGES], *edges = stackEdges;
+  GFXspan stackSpans[GFX_POLYGON_STACK_EDGES], *spans = stackSpans;
+  uint8_t *buf = NULL;
+  uint16_t i, j, next, nActive, nSpans;
+  int16_t a, b, row, yMin, yMax;
+
+  if (!n)
+    return;
+
+  if (n > GFX_POLYGON_STACK_EDGES) {
+    // One allocation for all three lists, pointers first for alignment
+    if (!(buf = (uint8_t *)malloc(n * (sizeof(GFXpolyEdge *) +
+                                       sizeof(GFXpolyEdge) + sizeof(GFXspan)))))
+      return;
+    active = (GFXpolyEdge **)buf;
+    edges = (GFXpolyEdge *)&active[n];
+    spans = (GFXspan *)&edges[n];
+  }
+
+  // Build the edge table, insertion-sorted by top row
+  yMin = yMax = y[0];
+  for (i = 0; i < n; i++) {
+    GFXpolyEdge pe;
+    int16_t xa = x[i], ya = y[i];
+    int16_t xb = x[(i + 1 < n) ? i + 1 : 0], yb = y[(i + 1 < n) ? i + 1 : 0];
+    if (ya > yb) {
+      _swap_int16_t(xa, xb);
+      _swap_int16_t(ya, yb);
+    }
+    pe.y0 = ya;
+    pe.y1 = yb;
+    if (ya == yb) { // Horizontal edge, stored as a left-right span
+      pe.e.x = min(xa, xb);
+      pe.x1 = (xa > xb) ? xa : xb;
+    } else {
+      pe.e.init(xa, ya, xb, yb);
+      pe.x1 = xb;
+    }
+    if (ya < yMin)
+      yMin = ya;
+    if (yb > yMax)
+      yMax = yb;
+    for (j = i; (j > 0) && (edges[j - 1].y0 > ya); j--)
+      edges[j] = edges[j - 1];
+    edges[j] = pe;
+  }
+
+  // Rows above or below the display (or clip rectangle) are skipped
+  // without being walked
+  row = yMin;
+  clipRows(row, yMax);
+
+  startWrite();
+  for (next = nActive = 0; row <= yMax; row++) {
+    nSpans = 0;
+
+    // Move edges starting on this row (or above it, if clipped) into the
+    // active edge list. Horizontal edges are drawn only on their own row
+    // and never become active.
+    while ((next < n) && (edges[next].y0 <= row)) {
+      GFXpolyEdge *pe = &edges[next++];
+      if (pe->y0 == pe->y1) {
+        if (pe->y0 == row) {
+          spans[nSpans].x0 = pe->e.x;
+          spans[nSpans++].x1 = pe->x1;
+        }
+      } else if (pe->y1 >= row) {
+        pe->e.seek(row - pe->y0);
+        active[nActive++] = pe;
+      }
+    }
+
+    // Edges cover rows y0 through y1-1 for the purpose of pairing up
+    // crossings, so vertices aren't counted twice. An edge's bottom vertex
+    // is still drawn though, on the row where the edge is retired.
+    for (i = 0; i < nActive;) {
+      if (active[i]->y1 == row) {
+        spans[nSpans].x0 = spans[nSpans].x1 = active[i]->x1;
+        nSpans++;
+        active[i] = active[--nActive];
+      } else {
+        i++;
+      }
+    }
+
+    // Sort active edges by X (insertion sort, as order changes little
+    // from one row to the next), fill between pairs of crossings
+    for (i = 1; i < nActive; i++) {
+      GFXpolyEdge *pe = active[i];
+      for (j = i; (j > 0) && (active[j - 1]->e.x > pe->e.x); j--)
+        active[j] = active[j - 1];
+      active[j] = pe;
+    }
+    for (i = 0; i + 1 < nActive; i += 2) {
+      spans[nSpans].x0 = active[i]->e.x;
+      spans[nSpans++].x1 = active[i + 1]->e.x;
+    }
+
+    // Sort spans by left edge, merge any that overlap or touch, so each
+    // pixel is written only once
+    for (i = 1; i < nSpans; i++) {
+      GFXspan sp = spans[i];
+      for (j = i; (j > 0) && (spans[j - 1].x0 > sp.x0); j--)
+        spans[j] = spans[j - 1];
+      spans[j] = sp;
+    }
+    for (i = 0; i < nSpans;) {
+      a = spans[i].x0;
+      b = spans[i].x1;
+      for (i++; (i < nSpans) && (spans[i].x0 <= b + 1); i++) {
+        if (spans[i].x1 > b)
+          b = spans[i].x1;
+      }
+      writeSpan(a, b, row, color);
+    }
+
+    for (i = 0; i < nActive; i++)
+      active[i]->e.step();
   }
   endWrite();
+
+  free(buf); // NULL (no-op) if stack lists were used
 }
 
 // BITMAP / XBITMAP / GRAYSCALE / RGB BITMAP FUNCTIONS ---------------------
@@ -1354,191 +1756,757 @@ void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
   endWrite();
 }
 
-// TEXT- AND CHARACTER-HANDLING FUNCTIONS ----------------------------------
+// CANVAS-TO-DISPLAY COPY FUNCTIONS ----------------------------------------
 
-// Draw a character
 /**************************************************************************/
 /*!
-   @brief   Draw a single character
-    @param    x   Bottom left corner x coordinate
-    @param    y   Bottom left corner y coordinate
-    @param    c   The 8-bit font-indexed character (likely ascii)
-    @param    color 16-bit 5-6-5 Color to draw chraracter with
-    @param    bg 16-bit 5-6-5 Color to fill background with (if same as color,
-   no background)
-    @param    size  Font magnification level, 1 is 'original' size
+   @brief   Copy an area of a 1-bit canvas to the specified (x,y) position,
+   using the specified foreground color (unset pixels are transparent). Both
+   canvases use their own rotation; the area is clipped to the source canvas,
+   this display and the clip rectangle. A canvas may be copied onto itself,
+   even to an overlapping area (e.g. to scroll part of it).
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    src Canvas to copy from
+    @param    sx  Top left corner x coordinate of area within src
+    @param    sy  Top left corner y coordinate of area within src
+    @param    w   Width of area in pixels
+    @param    h   Height of area in pixels
+    @param    color 16-bit 5-6-5 Color to draw set pixels with
 */
 /**************************************************************************/
-void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
-                            uint16_t color, uint16_t bg, uint8_t size) {
-  drawChar(x, y, c, color, bg, size, size);
+void Adafruit_GFX::drawCanvas(int16_t x, int16_t y, const GFXcanvas1 &src,
+                              int16_t sx, int16_t sy, int16_t w, int16_t h,
+                              uint16_t color) {
+  if (clipCanvas(x, y, src, sx, sy, w, h)) {
+    int8_t dx, dy;
+    startWrite();
+    for (int16_t n = overlapStrips(x, y, src, sx, sy, w, h, dx, dy); n--;
+         x += dx, y += dy, sx += dx, sy += dy)
+      blitCanvas(x, y, src, sx, sy, w, h, color, 0, false);
+    endWrite();
+  }
 }
 
-// Draw a character
 /**************************************************************************/
 /*!
-   @brief   Draw a single character
-    @param    x   Bottom left corner x coordinate
-    @param    y   Bottom left corner y coordinate
-    @param    c   The 8-bit font-indexed character (likely ascii)
-    @param    color 16-bit 5-6-5 Color to draw chraracter with
-    @param    bg 16-bit 5-6-5 Color to fill background with (if same as color,
-   no background)
-    @param    size_x  Font magnification level in X-axis, 1 is 'original' size
-    @param    size_y  Font magnification level in Y-axis, 1 is 'original' size
+   @brief   Copy an area of a 1-bit canvas to the specified (x,y) position,
+   using the specified foreground (for set pixels) and background (unset
+   pixels) colors. Both canvases use their own rotation; the area is clipped
+   to the source canvas, this display and the clip rectangle.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    src Canvas to copy from
+    @param    sx  Top left corner x coordinate of area within src
+    @param    sy  Top left corner y coordinate of area within src
+    @param    w   Width of area in pixels
+    @param    h   Height of area in pixels
+    @param    color 16-bit 5-6-5 Color to draw set pixels with
+    @param    bg 16-bit 5-6-5 Color to draw unset pixels with
 */
 /**************************************************************************/
-void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
-                            uint16_t color, uint16_t bg, uint8_t size_x,
-                            uint8_t size_y) {
-
-  if (!gfxFont) { // 'Classic' built-in font
-
-    if ((x >= _width) ||              // Clip right
-        (y >= _height) ||             // Clip bottom
-        ((x + 6 * size_x - 1) < 0) || // Clip left
-        ((y + 8 * size_y - 1) < 0))   // Clip top
-      return;
-
-    if (!_cp437 && (c >= 176))
-      c++; // Handle 'classic' charset behavior
-
+void Adafruit_GFX::drawCanvas(int16_t x, int16_t y, const GFXcanvas1 &src,
+                              int16_t sx, int16_t sy, int16_t w, int16_t h,
+                              uint16_t color, uint16_t bg) {
+  if (clipCanvas(x, y, src, sx, sy, w, h)) {
+    int8_t dx, dy;
     startWrite();
-    for (int8_t i = 0; i < 5; i++) { // Char bitmap = 5 columns
-      uint8_t line = pgm_read_byte(&font[c * 5 + i]);
-      for (int8_t j = 0; j < 8; j++, line >>= 1) {
-        if (line & 1) {
-          if (size_x == 1 && size_y == 1)
-            writePixel(x + i, y + j, color);
-          else
-            writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y,
-                          color);
-        } else if (bg != color) {
-          if (size_x == 1 && size_y == 1)
-            writePixel(x + i, y + j, bg);
-          else
-            writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y, bg);
-        }
-      }
-    }
-    if (bg != color) { // If opaque, draw vertical line for last column
-      if (size_x == 1 && size_y == 1)
-        writeFastVLine(x + 5, y, 8, bg);
-      else
-        writeFillRect(x + 5 * size_x, y, size_x, 8 * size_y, bg);
-    }
+    for (int16_t n = overlapStrips(x, y, src, sx, sy, w, h, dx, dy); n--;
+         x += dx, y += dy, sx += dx, sy += dy)
+      blitCanvas(x, y, src, sx, sy, w, h, color, bg, true);
     endWrite();
+  }
+}
 
-  } else { // Custom font
-
-    // Character is assumed previously filtered by write() to eliminate
-    // newlines, returns, non-printable characters, etc.  Calling
-    // drawChar() directly with 'bad' characters of font may cause mayhem!
-
-    c -= (uint8_t)pgm_read_byte(&gfxFont->first);
-    GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c);
-    uint8_t *bitmap = pgm_read_bitmap_ptr(gfxFont);
-
-    uint16_t bo = pgm_read_word(&glyph->bitmapOffset);
-    uint8_t w = pgm_read_byte(&glyph->width), h = pgm_read_byte(&glyph->height);
-    int8_t xo = pgm_read_byte(&glyph->xOffset),
-           yo = pgm_read_byte(&glyph->yOffset);
-    uint8_t xx, yy, bits = 0, bit = 0;
-    int16_t xo16 = 0, yo16 = 0;
-
-    if (size_x > 1 || size_y > 1) {
-      xo16 = xo;
-      yo16 = yo;
-    }
-
-    // Todo: Add character clipping here
-
-    // NOTE: THERE IS NO 'BACKGROUND' COLOR OPTION ON CUSTOM FONTS.
-    // THIS IS ON PURPOSE AND BY DESIGN.  The background color feature
-    // has typically been used with the 'classic' font to overwrite old
-    // screen contents with new data.  This ONLY works because the
-    // characters are a uniform size; it's not a sensible thing to do with
-    // proportionally-spaced fonts with glyphs of varying sizes (and that
-    // may overlap).  To replace previously-drawn text when using a custom
-    // font, use the getTextBounds() function to determine the smallest
-    // rectangle encompassing a string, erase the area with fillRect(),
-    // then draw new text.  This WILL infortunately 'blink' the text, but
-    // is unavoidable.  Drawing 'background' pixels will NOT fix this,
-    // only creates a new set of problems.  Have an idea to work around
-    // this (a canvas object type for MCUs that can afford the RAM and
-    // displays supporting setAddrWindow() and pushColors()), but haven't
-    // implemented this yet.
-
+/**************************************************************************/
+/*!
+   @brief   Copy an area of an 8-bit canvas to the specified (x,y) position,
+   optionally converting each value to a color through a palette. Both
+   canvases use their own rotation; the area is clipped to the source canvas,
+   this display and the clip rectangle. The source may be this same canvas,
+   and the areas may overlap.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    src Canvas to copy from
+    @param    sx  Top left corner x coordinate of area within src
+    @param    sy  Top left corner y coordinate of area within src
+    @param    w   Width of area in pixels
+    @param    h   Height of area in pixels
+    @param    palette 256 16-bit colors to draw each value with, or NULL to
+              use the canvas's own palette (see GFXcanvas8::setPalette()),
+              drawing the 8-bit values themselves if it has none
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawCanvas(int16_t x, int16_t y, const GFXcanvas8 &src,
+                              int16_t sx, int16_t sy, int16_t w, int16_t h,
+                              const uint16_t *palette) {
+  if (clipCanvas(x, y, src, sx, sy, w, h)) {
+    int8_t dx, dy;
     startWrite();
-    for (yy = 0; yy < h; yy++) {
-      for (xx = 0; xx < w; xx++) {
-        if (!(bit++ & 7)) {
-          bits = pgm_read_byte(&bitmap[bo++]);
-        }
-        if (bits & 0x80) {
-          if (size_x == 1 && size_y == 1) {
-            writePixel(x + xo + xx, y + yo + yy, color);
-          } else {
-            writeFillRect(x + (xo16 + xx) * size_x, y + (yo16 + yy) * size_y,
-                          size_x, size_y, color);
-          }
-        }
-        bits <<= 1;
-      }
-    }
+    for (int16_t n = overlapStrips(x, y, src, sx, sy, w, h, dx, dy); n--;
+         x += dx, y += dy, sx += dx, sy += dy)
+      blitCanvas(x, y, src, sx, sy, w, h, palette ? palette : src.getPalette(),
+                 0, false);
     endWrite();
+  }
+}
 
-  } // End classic vs custom font
+/**************************************************************************/
+/*!
+   @brief   Copy an area of an 8-bit canvas to the specified (x,y) position,
+   skipping pixels of a key value (so they're transparent), and optionally
+   converting the others to colors through a palette.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    src Canvas to copy from
+    @param    sx  Top left corner x coordinate of area within src
+    @param    sy  Top left corner y coordinate of area within src
+    @param    w   Width of area in pixels
+    @param    h   Height of area in pixels
+    @param    palette 256 16-bit colors to draw each value with, or NULL to
+              use the canvas's own palette, if any
+    @param    key  Source value that is not drawn
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawCanvas(int16_t x, int16_t y, const GFXcanvas8 &src,
+                              int16_t sx, int16_t sy, int16_t w, int16_t h,
+                              const uint16_t *palette, uint8_t key) {
+  if (clipCanvas(x, y, src, sx, sy, w, h)) {
+    int8_t dx, dy;
+    startWrite();
+    for (int16_t n = overlapStrips(x, y, src, sx, sy, w, h, dx, dy); n--;
+         x += dx, y += dy, sx += dx, sy += dy)
+      blitCanvas(x, y, src, sx, sy, w, h, palette ? palette : src.getPalette(),
+                 key, true);
+    endWrite();
+  }
 }
+
 /**************************************************************************/
 /*!
-    @brief  Print one byte/character of data, used to support print()
-    @param  c  The 8-bit ascii character to write
+   @brief   Copy an area of a 16-bit canvas to the specified (x,y) position.
+   Both canvases use their own rotation; the area is clipped to the source
+   canvas, this display and the clip rectangle. The source may be this same
+   canvas, and the areas may overlap (e.g. to scroll part of it).
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    src Canvas to copy from
+    @param    sx  Top left corner x coordinate of area within src
+    @param    sy  Top left corner y coordinate of area within src
+    @param    w   Width of area in pixels
+    @param    h   Height of area in pixels
 */
 /**************************************************************************/
-size_t Adafruit_GFX::write(uint8_t c) {
-  if (!gfxFont) { // 'Classic' built-in font
+void Adafruit_GFX::drawCanvas(int16_t x, int16_t y, const GFXcanvas16 &src,
+                              int16_t sx, int16_t sy, int16_t w, int16_t h) {
+  if (clipCanvas(x, y, src, sx, sy, w, h)) {
+    int8_t dx, dy;
+    startWrite();
+    for (int16_t n = overlapStrips(x, y, src, sx, sy, w, h, dx, dy); n--;
+         x += dx, y += dy, sx += dx, sy += dy)
+      blitCanvas(x, y, src, sx, sy, w, h, 0, false);
+    endWrite();
+  }
+}
 
-    if (c == '\n') {              // Newline?
-      cursor_x = 0;               // Reset x to zero,
-      cursor_y += textsize_y * 8; // advance y one line
-    } else if (c != '\r') {       // Ignore carriage returns
-      if (wrap && ((cursor_x + textsize_x * 6) > _width)) { // Off right?
-        cursor_x = 0;                                       // Reset x to zero,
-        cursor_y += textsize_y * 8; // advance y one line
-      }
-      drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x,
-               textsize_y);
-      cursor_x += textsize_x * 6; // Advance x one char
-    }
+/**************************************************************************/
+/*!
+   @brief   Copy an area of a 16-bit canvas to the specified (x,y) position,
+   skipping pixels of a key color (so they're transparent).
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    src Canvas to copy from
+    @param    sx  Top left corner x coordinate of area within src
+    @param    sy  Top left corner y coordinate of area within src
+    @param    w   Width of area in pixels
+    @param    h   Height of area in pixels
+    @param    key  16-bit 5-6-5 Color that is not drawn
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawCanvas(int16_t x, int16_t y, const GFXcanvas16 &src,
+                              int16_t sx, int16_t sy, int16_t w, int16_t h,
+                              uint16_t key) {
+  if (clipCanvas(x, y, src, sx, sy, w, h)) {
+    int8_t dx, dy;
+    startWrite();
+    for (int16_t n = overlapStrips(x, y, src, sx, sy, w, h, dx, dy); n--;
+         x += dx, y += dy, sx += dx, sy += dy)
+      blitCanvas(x, y, src, sx, sy, w, h, key, true);
+    endWrite();
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Clip a canvas copy to the source canvas, then to both this
+            display and the clip rectangle, moving the source area along
+            with the destination.
+    @param  x    Destination left edge, updated upon return
+    @param  y    Destination top edge, updated upon return
+    @param  src  Canvas (or display) being copied from
+    @param  sx   Source left edge, updated upon return
+    @param  sy   Source top edge, updated upon return
+    @param  w    Width, updated upon return
+    @param  h    Height, updated upon return
+    @returns  false if nothing is left to draw
+*/
+/**************************************************************************/
+bool Adafruit_GFX::clipCanvas(int16_t &x, int16_t &y, const Adafruit_GFX &src,
+                              int16_t &sx, int16_t &sy, int16_t &w,
+                              int16_t &h) const {
+  // Negative sizes draw nothing, like the bitmap functions
+  int32_t x0 = x, y0 = y, sx0 = sx, sy0 = sy, sw = w, sh = h;
+  if (sx0 < 0) { // Trim area to source canvas
+    sw += sx0;
+    x0 -= sx0;
+    sx0 = 0;
+  }
+  if (sy0 < 0) {
+    sh += sy0;
+    y0 -= sy0;
+    sy0 = 0;
+  }
+  if (sx0 + sw > src.width())
+    sw = src.width() - sx0;
+  if (sy0 + sh > src.height())
+    sh = src.height() - sy0;
+  if ((sw < 1) || (sh < 1) || (x0 > 0x7FFF) || (y0 > 0x7FFF))
+    return false;
+  int16_t cx = x0, cy = y0, cw = sw, ch = sh;
+  if (!clipFillRect(cx, cy, cw, ch))
+    return false;
+  sx = sx0 + (cx - x0); // Same offset into source as clipping moved dest
+  sy = sy0 + (cy - y0);
+  x = cx;
+  y = cy;
+  w = cw;
+  h = ch;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Split an already-clipped canvas copy into strips that can be
+            copied one after another without reading pixels the copy has
+            already overwritten. Only needed when a canvas is copied onto
+            itself and the areas overlap; otherwise it's a single strip.
+            Each strip is a whole row (or column, if the areas share rows)
+            that doesn't overlap its own source, taken in order from the
+            end that moves away from the source.
+    @param  x    Destination left edge, set to the first strip's
+    @param  y    Destination top edge, set to the first strip's
+    @param  src  Canvas being copied from
+    @param  sx   Source left edge, set to the first strip's
+    @param  sy   Source top edge, set to the first strip's
+    @param  w    Width, set to the strip width
+    @param  h    Height, set to the strip height
+    @param  dx   Returned x step (destination and source) between strips
+    @param  dy   Returned y step (destination and source) between strips
+    @returns  Number of strips
+*/
+/**************************************************************************/
+int16_t Adafruit_GFX::overlapStrips(int16_t &x, int16_t &y,
+                                    const Adafruit_GFX &src, int16_t &sx,
+                                    int16_t &sy, int16_t &w, int16_t &h,
+                                    int8_t &dx, int8_t &dy) const {
+  int16_t n;
+
+  dx = dy = 0;
+  // Different canvas or no overlap, copy in one go
+  if ((&src != this) || ((x == sx) && (y == sy)) || (x >= sx + w) ||
+      (sx >= x + w) || (y >= sy + h) || (sy >= y + h))
+    return 1;
+  if (y != sy) { // Row by row
+    n = h;
+    h = 1;
+    dy = (y > sy) ? -1 : 1;
+    if (dy < 0) { // Moving down, start at the bottom
+      y += n - 1;
+      sy += n - 1;
+    }
+  } else { // Same rows, column by column
+    n = w;
+    w = 1;
+    dx = (x > sx) ? -1 : 1;
+    if (dx < 0) { // Moving right, start at the right
+      x += n - 1;
+      sx += n - 1;
+    }
+  }
+  return n;
+}
+
+/**************************************************************************/
+/*!
+   @brief   Copy an already-clipped area of a 1-bit canvas, a pixel at a
+   time. Subclasses with a framebuffer may override this to copy directly.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    src Canvas to copy from
+    @param    sx  Top left corner x coordinate of area within src
+    @param    sy  Top left corner y coordinate of area within src
+    @param    w   Width of area in pixels
+    @param    h   Height of area in pixels
+    @param    color  Color to draw set pixels with
+    @param    bg     Color to draw unset pixels with
+    @param    opaque If false, unset pixels are transparent and bg is ignored
+*/
+/**************************************************************************/
+void Adafruit_GFX::blitCanvas(int16_t x, int16_t y, const GFXcanvas1 &src,
+                              int16_t sx, int16_t sy, int16_t w, int16_t h,
+                              uint16_t color, uint16_t bg, bool opaque) {
+  for (int16_t j = 0; j < h; j++) {
+    for (int16_t i = 0; i < w; i++) {
+      if (src.getPixel(sx + i, sy + j))
+        writePixel(x + i, y + j, color);
+      else if (opaque)
+        writePixel(x + i, y + j, bg);
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Copy an already-clipped area of an 8-bit canvas, a pixel at a
+   time. Subclasses with a framebuffer may override this to copy directly.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    src Canvas to copy from
+    @param    sx  Top left corner x coordinate of area within src
+    @param    sy  Top left corner y coordinate of area within src
+    @param    w   Width of area in pixels
+    @param    h   Height of area in pixels
+    @param    palette 256 colors to draw each value with, or NULL
+    @param    key    Source value that is not drawn, if keyed
+    @param    keyed  If true, pixels of the key value are transparent
+*/
+/**************************************************************************/
+void Adafruit_GFX::blitCanvas(int16_t x, int16_t y, const GFXcanvas8 &src,
+                              int16_t sx, int16_t sy, int16_t w, int16_t h,
+                              const uint16_t *palette, uint8_t key,
+                              bool keyed) {
+  for (int16_t j = 0; j < h; j++) {
+    for (int16_t i = 0; i < w; i++) {
+      uint8_t v = src.getPixel(sx + i, sy + j);
+      if (!keyed || (v != key))
+        writePixel(x + i, y + j, palette ? palette[v] : v);
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Copy an already-clipped area of a 16-bit canvas, a pixel at a
+   time. Subclasses with a framebuffer may override this to copy directly.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    src Canvas to copy from
+    @param    sx  Top left corner x coordinate of area within src
+    @param    sy  Top left corner y coordinate of area within src
+    @param    w   Width of area in pixels
+    @param    h   Height of area in pixels
+    @param    key    Color that is not drawn, if keyed
+    @param    keyed  If true, pixels of the key color are transparent
+*/
+/**************************************************************************/
+void Adafruit_GFX::blitCanvas(int16_t x, int16_t y, const GFXcanvas16 &src,
+                              int16_t sx, int16_t sy, int16_t w, int16_t h,
+                              uint16_t key, bool keyed) {
+  for (int16_t j = 0; j < h; j++) {
+    for (int16_t i = 0; i < w; i++) {
+      uint16_t c = src.getPixel(sx + i, sy + j);
+      if (!keyed || (c != key))
+        writePixel(x + i, y + j, c);
+    }
+  }
+}
+
+// TEXT- AND CHARACTER-HANDLING FUNCTIONS ----------------------------------
+
+// Draw a character
+/**************************************************************************/
+/*!
+   @brief   Set up (or remove) a cache of pre-decoded custom font glyphs.
+            Each cached glyph keeps its metrics and its set pixels as
+            horizontal runs in RAM, so drawing it again skips the PROGMEM
+            reads and bit unpacking. Useful when the same few characters
+            (e.g. digits) are redrawn constantly. The least recently used
+            glyph is replaced when the cache is full. Uses about
+            (16 + 3 * maxRuns) bytes per glyph, plus 60 or so for the
+            cache itself. The hit/miss counters are reset.
+    @param  glyphs   Number of glyphs to keep, 0 to remove the cache
+    @param  maxRuns  Max runs of set pixels per glyph (a run per row is
+                     typical of small glyphs, some rows of bigger ones need
+                     a few). Glyphs needing more are drawn but not cached,
+                     and don't evict anything.
+    @returns  true on success, false if the cache can't be allocated (or
+              was removed)
+*/
+/**************************************************************************/
+bool Adafruit_GFX::setGlyphCache(uint8_t glyphs, uint8_t maxRuns) {
+  free(glyphCache);
+  glyphCache = NULL;
+  if (!glyphs || !maxRuns)
+    return false;
+
+  // One allocation: header, then entries, then runs
+  GFXglyphCache *gc = (GFXglyphCache *)calloc(
+      1, sizeof(GFXglyphCache) + glyphs * sizeof(GFXcachedGlyph) +
+             glyphs * maxRuns * 3);
+  if (!gc)
+    return false;
+  gc->glyphs = (GFXcachedGlyph *)&gc[1];
+  gc->runs = (uint8_t *)&gc->glyphs[glyphs];
+  gc->size = glyphs;
+  gc->maxRuns = maxRuns;
+  glyphCache = gc;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+   @brief   Get the number of custom font glyphs drawn from the glyph cache
+   @returns Hit count since setGlyphCache(), 0 if there's no cache
+*/
+/**************************************************************************/
+uint32_t Adafruit_GFX::getGlyphCacheHits(void) const {
+  return glyphCache ? glyphCache->hits : 0;
+}
+
+/**************************************************************************/
+/*!
+   @brief   Get the number of custom font glyphs that weren't in the glyph
+            cache and had to be decoded
+   @returns Miss count since setGlyphCache(), 0 if there's no cache
+*/
+/**************************************************************************/
+uint32_t Adafruit_GFX::getGlyphCacheMisses(void) const {
+  return glyphCache ? glyphCache->misses : 0;
+}
+
+/**************************************************************************/
+/*!
+   @brief   Find a glyph of the current font in the glyph cache, decoding it
+            into the least recently used entry if it's not there. The
+            cache must exist.
+    @param  c  Glyph index within font (character minus font's first)
+    @returns  The cache entry, or NULL if the glyph has too many runs to
+              be cached (such glyphs are remembered, not decoded again)
+*/
+/**************************************************************************/
+GFXcachedGlyph *Adafruit_GFX::cacheGlyph(uint8_t c) {
+  GFXglyphCache *gc = glyphCache;
+  GFXcachedGlyph *g = gc->glyphs, *lru = g;
+
+  gc->tick++;
+  for (uint8_t i = 0; i < gc->size; i++, g++) {
+    if ((g->font == gfxFont) && (g->c == c)) {
+      g->lastUsed = gc->tick;
+      gc->hits++;
+      return g;
+    }
+    if (g->lastUsed < lru->lastUsed)
+      lru = g;
+  }
+  gc->misses++;
+
+  if (gc->noFitFont != gfxFont) { // Uncacheable glyphs are per font
+    memset(gc->noFit, 0, sizeof(gc->noFit));
+    gc->noFitFont = gfxFont;
+  }
+  if (gc->noFit[c >> 3] & (1 << (c & 7)))
+    return NULL; // Known to be too complex, draw from PROGMEM
+
+  GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c);
+  uint8_t w = pgm_read_byte(&glyph->width), h = pgm_read_byte(&glyph->height);
+  GFXglyphBits bits;
+  uint8_t xx, yy, n = 0;
+  int16_t run;
+
+  // Count runs first, so a glyph that won't fit doesn't evict an entry
+  uint16_t numRuns = 0;
+  glyphBitsBegin(&bits, gfxFont, gfxFont2, c);
+  for (yy = 0; yy < h; yy++) {
+    bool prev = false;
+    for (xx = 0; xx < w; xx++) {
+      bool set = glyphBitsNext(&bits);
+      if (set && !prev && (++numRuns > gc->maxRuns)) {
+        gc->noFit[c >> 3] |= 1 << (c & 7);
+        return NULL;
+      }
+      prev = set;
+    }
+  }
+
+  uint8_t *r = &gc->runs[(lru - gc->glyphs) * gc->maxRuns * 3];
+  glyphBitsBegin(&bits, gfxFont, gfxFont2, c);
+  lru->c = c;
+  lru->width = w;
+  lru->height = h;
+  lru->xOffset = pgm_read_byte(&glyph->xOffset);
+  lru->yOffset = pgm_read_byte(&glyph->yOffset);
+
+  for (yy = 0; yy < h; yy++) {
+    run = -1;
+    for (xx = 0; xx <= w; xx++) { // One extra to end last run
+      if ((xx < w) && glyphBitsNext(&bits)) {
+        if (run < 0)
+          run = xx;
+      } else if (run >= 0) {
+        *r++ = yy;
+        *r++ = run;
+        *r++ = xx - run;
+        n++;
+        run = -1;
+      }
+    }
+  }
+
+  lru->numRuns = n;
+  lru->font = gfxFont;
+  lru->lastUsed = gc->tick;
+  return lru;
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a horizontal run of set bits from a custom font glyph, as
+            one line (or rectangle, if scaled). Clipping is left to the
+            write functions.
+    @param    x   Character origin x coordinate
+    @param    y   Character origin y coordinate (baseline)
+    @param    xo  Glyph x offset from origin, in font pixels
+    @param    yo  Glyph y offset from origin, in font pixels
+    @param    xx  First glyph column of run
+    @param    len Number of glyph columns in run
+    @param    yy  Glyph row of run
+    @param    size_x  Font magnification level in X-axis, 1 is 'original' size
+    @param    size_y  Font magnification level in Y-axis, 1 is 'original' size
+    @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_GFX::writeGlyphRun(int16_t x, int16_t y, int8_t xo, int8_t yo,
+                                 int16_t xx, int16_t len, int16_t yy,
+                                 uint8_t size_x, uint8_t size_y,
+                                 uint16_t color) {
+  if (size_x == 1 && size_y == 1) {
+    writeFastHLine(x + xo + xx, y + yo + yy, len, color);
+  } else {
+    writeFillRect(x + (xo + xx) * size_x, y + (yo + yy) * size_y,
+                  len * size_x, size_y, color);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a single character
+    @param    x   Bottom left corner x coordinate
+    @param    y   Bottom left corner y coordinate
+    @param    c   The 8-bit font-indexed character (likely ascii)
+    @param    color 16-bit 5-6-5 Color to draw chraracter with
+    @param    bg 16-bit 5-6-5 Color to fill background with (if same as color,
+   no background)
+    @param    size  Font magnification level, 1 is 'original' size
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
+                            uint16_t color, uint16_t bg, uint8_t size) {
+  drawChar(x, y, c, color, bg, size, size);
+}
+
+// Draw a character
+/**************************************************************************/
+/*!
+   @brief   Draw a single character
+    @param    x   Bottom left corner x coordinate
+    @param    y   Bottom left corner y coordinate
+    @param    c   The 8-bit font-indexed character (likely ascii)
+    @param    color 16-bit 5-6-5 Color to draw chraracter with
+    @param    bg 16-bit 5-6-5 Color to fill background with (if same as color,
+   no background)
+    @param    size_x  Font magnification level in X-axis, 1 is 'original' size
+    @param    size_y  Font magnification level in Y-axis, 1 is 'original' size
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
+                            uint16_t color, uint16_t bg, uint8_t size_x,
+                            uint8_t size_y) {
+  startWrite();
+  writeChar(x, y, c, color, bg, size_x, size_y);
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a single character, within a transaction already started
+            with startWrite() (see drawChar())
+    @param    x   Bottom left corner x coordinate
+    @param    y   Bottom left corner y coordinate
+    @param    c   The 8-bit font-indexed character (likely ascii)
+    @param    color 16-bit 5-6-5 Color to draw chraracter with
+    @param    bg 16-bit 5-6-5 Color to fill background with (if same as color,
+   no background)
+    @param    size_x  Font magnification level in X-axis, 1 is 'original' size
+    @param    size_y  Font magnification level in Y-axis, 1 is 'original' size
+*/
+/**************************************************************************/
+void Adafruit_GFX::writeChar(int16_t x, int16_t y, unsigned char c,
+                             uint16_t color, uint16_t bg, uint8_t size_x,
+                             uint8_t size_y) {
+
+  if (!gfxFont) { // 'Classic' built-in font
+
+    if ((x >= _width) ||              // Clip right
+        (y >= _height) ||             // Clip bottom
+        ((x + 6 * size_x - 1) < 0) || // Clip left
+        ((y + 8 * size_y - 1) < 0))   // Clip top
+      return;
+
+    if (!_cp437 && (c >= 176))
+      c++; // Handle 'classic' charset behavior
+
+    for (int8_t i = 0; i < 5; i++) { // Char bitmap = 5 columns
+      uint8_t line = pgm_read_byte(&font[c * 5 + i]);
+      for (int8_t j = 0; j < 8; j++, line >>= 1) {
+        if (line & 1) {
+          if (size_x == 1 && size_y == 1)
+            writePixel(x + i, y + j, color);
+          else
+            writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y,
+                          color);
+        } else if (bg != color) {
+          if (size_x == 1 && size_y == 1)
+            writePixel(x + i, y + j, bg);
+          else
+            writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y, bg);
+        }
+      }
+    }
+    if (bg != color) { // If opaque, draw vertical line for last column
+      if (size_x == 1 && size_y == 1)
+        writeFastVLine(x + 5, y, 8, bg);
+      else
+        writeFillRect(x + 5 * size_x, y, size_x, 8 * size_y, bg);
+    }
 
   } else { // Custom font
 
-    if (c == '\n') {
-      cursor_x = 0;
-      cursor_y +=
-          (int16_t)textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
-    } else if (c != '\r') {
-      uint8_t first = pgm_read_byte(&gfxFont->first);
-      if ((c >= first) && (c <= (uint8_t)pgm_read_byte(&gfxFont->last))) {
-        GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c - first);
-        uint8_t w = pgm_read_byte(&glyph->width),
-                h = pgm_read_byte(&glyph->height);
-        if ((w > 0) && (h > 0)) { // Is there an associated bitmap?
-          int16_t xo = (int8_t)pgm_read_byte(&glyph->xOffset); // sic
-          if (wrap && ((cursor_x + textsize_x * (xo + w)) > _width)) {
-            cursor_x = 0;
-            cursor_y += (int16_t)textsize_y *
-                        (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
-          }
-          drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x,
-                   textsize_y);
+    // Character is assumed previously filtered by write() to eliminate
+    // newlines, returns, non-printable characters, etc.  Calling
+    // drawChar() directly with 'bad' characters of font may cause mayhem!
+
+    c -= (uint8_t)pgm_read_byte(&gfxFont->first);
+    GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c);
+
+    uint8_t w, h, xx, yy;
+    int8_t xo, yo;
+    int16_t run;
+
+    // With the glyph cache, metrics and runs of set pixels come from RAM.
+    // Else they're decoded from PROGMEM while drawing.
+    GFXcachedGlyph *cached = glyphCache ? cacheGlyph(c) : NULL;
+    if (cached) {
+      w = cached->width;
+      h = cached->height;
+      xo = cached->xOffset;
+      yo = cached->yOffset;
+    } else {
+      w = pgm_read_byte(&glyph->width);
+      h = pgm_read_byte(&glyph->height);
+      xo = pgm_read_byte(&glyph->xOffset);
+      yo = pgm_read_byte(&glyph->yOffset);
+    }
+
+    if (!w || !h)
+      return; // Nothing to draw (e.g. space)
+
+    // Character clipping: find the glyph's bounding box on the display,
+    // reject it outright if nothing's visible, else narrow the rows and
+    // columns to be decoded down to just the visible ones.
+    int32_t gx0 = x + (int32_t)xo * size_x, gy0 = y + (int32_t)yo * size_y;
+    int32_t gx1 = gx0 + w * size_x - 1, gy1 = gy0 + h * size_y - 1;
+    int16_t cx0 = -0x7FFF - 1, cx1 = 0x7FFF, cy0 = -0x7FFF - 1, cy1 = 0x7FFF;
+    clipColumns(cx0, cx1);
+    clipRows(cy0, cy1);
+    if ((gx0 > cx1) || (gx1 < cx0) || (gy0 > cy1) || (gy1 < cy0))
+      return;
+    uint8_t xxFirst = (gx0 < cx0) ? (cx0 - gx0) / size_x : 0;
+    uint8_t xxLast = (gx1 > cx1) ? (cx1 - gx0) / size_x : w - 1;
+    uint8_t yyFirst = (gy0 < cy0) ? (cy0 - gy0) / size_y : 0;
+    uint8_t yyLast = (gy1 > cy1) ? (cy1 - gy0) / size_y : h - 1;
+
+    // NOTE: THERE IS NO 'BACKGROUND' COLOR OPTION ON CUSTOM FONTS.
+    // THIS IS ON PURPOSE AND BY DESIGN.  The background color feature
+    // has typically been used with the 'classic' font to overwrite old
+    // screen contents with new data.  This ONLY works because the
+    // characters are a uniform size; it's not a sensible thing to do with
+    // proportionally-spaced fonts with glyphs of varying sizes (and that
+    // may overlap).  To replace previously-drawn text when using a custom
+    // font, use the getTextBounds() function to determine the smallest
+    // rectangle encompassing a string, erase the area with fillRect(),
+    // then draw new text.  This WILL infortunately 'blink' the text.
+    // Drawing 'background' pixels per glyph will NOT fix this, only
+    // creates a new set of problems.  To avoid the blink, use
+    // drawOpaqueText(), which composes the whole string before drawing
+    // it along with its background.
+
+    // Glyph bits are packed continuously (rows aren't byte-aligned, or are
+    // RLE-compressed), so the invisible parts of each row are skipped over
+    // and only the visible part is decoded. Runs of set bits are drawn as
+    // one line or rect each, rather than a pixel (i.e. a whole address
+    // window setup on many displays) per bit.
+    if (cached) {
+      uint8_t *r = &glyphCache->runs[(cached - glyphCache->glyphs) *
+                                     glyphCache->maxRuns * 3];
+      for (uint8_t n = cached->numRuns; n--; r += 3) { // Runs go row by row
+        if (r[0] < yyFirst)
+          continue;
+        if (r[0] > yyLast)
+          break;
+        run = (r[1] > xxFirst) ? r[1] : xxFirst;
+        int16_t end = (r[1] + r[2] - 1 < xxLast) ? r[1] + r[2] - 1 : xxLast;
+        if (run <= end)
+          writeGlyphRun(x, y, xo, yo, run, end - run + 1, r[0], size_x,
+                        size_y, color);
+      }
+      return;
+    }
+    GFXglyphBits bits;
+    glyphBitsBegin(&bits, gfxFont, gfxFont2, c);
+    glyphBitsSkip(&bits, yyFirst * w);
+    for (yy = yyFirst; yy <= yyLast; yy++) {
+      glyphBitsSkip(&bits, xxFirst);
+      run = -1; // Start column of current run of set bits, -1 if none
+      for (xx = xxFirst; xx <= xxLast; xx++) {
+        if (glyphBitsNext(&bits)) {
+          if (run < 0)
+            run = xx;
+        } else if (run >= 0) {
+          writeGlyphRun(x, y, xo, yo, run, xx - run, yy, size_x, size_y,
+                        color);
+          run = -1;
         }
-        cursor_x +=
-            (uint8_t)pgm_read_byte(&glyph->xAdvance) * (int16_t)textsize_x;
       }
+      glyphBitsSkip(&bits, w - 1 - xxLast);
+      if (run >= 0)
+        writeGlyphRun(x, y, xo, yo, run, xxLast - run + 1, yy, size_x,
+                      size_y, color);
     }
-  }
+
+  } // End classic vs custom font
+}
+/**************************************************************************/
+/*!
+    @brief  Print one byte/character of data, used to support print()
+    @param  c  The 8-bit ascii character to write
+*/
+/**************************************************************************/
+size_t Adafruit_GFX::write(uint8_t c) {
+  int16_t gx, gy, bx, by, bw, bh;
+  if (layoutChar(c, &cursor_x, &cursor_y, &gx, &gy, &bx, &by, &bw, &bh,
+                 &prevChar) &&
+      bw && bh)
+    drawChar(gx, gy, c, textcolor, textbgcolor, textsize_x, textsize_y);
   return 1;
 }
 
@@ -1566,7 +2534,9 @@ void Adafruit_GFX::setTextSize(uint8_t s_x, uint8_t s_y) {
 
 /**************************************************************************/
 /*!
-    @brief      Set rotation setting for display
+    @brief      Set rotation setting for display. Also removes any clip
+                rectangle; subclasses overriding this should do the same,
+                by calling this or resetClipRect().
     @param  x   0 thru 3 corresponding to 4 cardinal rotations
 */
 /**************************************************************************/
@@ -1584,6 +2554,274 @@ void Adafruit_GFX::setRotation(uint8_t x) {
     _height = WIDTH;
     break;
   }
+  resetClipRect(); // Old clip is meaningless in the new orientation
+}
+
+/**************************************************************************/
+/*!
+    @brief  Limit all drawing to a rectangle, e.g. to redraw just part of a
+            widget. Everything drawn afterward (lines, shapes, bitmaps,
+            text...) is clipped to this area as well as to the display, so
+            pixels outside it are never touched. Coordinates are relative to
+            the current rotation. Adafruit_GFX::setRotation() resets the
+            clip, but display drivers that override setRotation() without
+            calling it don't, so after rotating those, call resetClipRect()
+            (or set a new clip). Subclasses that override the drawing
+            functions must honor the clip too, see inClip() and clipRect().
+    @param  x  Left edge
+    @param  y  Top edge
+    @param  w  Width in pixels (0 or less disables all drawing)
+    @param  h  Height in pixels (0 or less disables all drawing)
+*/
+/**************************************************************************/
+void Adafruit_GFX::setClipRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if ((w <= 0) || (h <= 0)) { // Empty, x + w - 1 might not fit in 16 bits
+    _clip.x0 = _clip.y0 = 0;
+    _clip.x1 = _clip.y1 = -1;
+  } else {
+    int32_t x1 = (int32_t)x + w - 1, y1 = (int32_t)y + h - 1;
+    _clip.x0 = x;
+    _clip.y0 = y;
+    _clip.x1 = (x1 > 0x7FFF) ? 0x7FFF : x1;
+    _clip.y1 = (y1 > 0x7FFF) ? 0x7FFF : y1;
+  }
+  _clipActive = true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Remove the clip rectangle and any saved by pushClip(), so
+            drawing is limited only by the display bounds.
+*/
+/**************************************************************************/
+void Adafruit_GFX::resetClipRect(void) {
+  _clip.x0 = _clip.y0 = -0x7FFF - 1;
+  _clip.x1 = _clip.y1 = 0x7FFF;
+  _clipActive = false;
+  _clipDepth = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Save the current clip rectangle, then narrow it to the part
+            that's also within a new rectangle. Undo with popClip(). Handy
+            for nested widgets, as the child can't draw outside its parent.
+    @param  x  Left edge
+    @param  y  Top edge
+    @param  w  Width in pixels
+    @param  h  Height in pixels
+    @returns  true on success, false if GFX_CLIP_STACK_DEPTH clips are
+              already saved (nothing is changed, and popClip() should NOT
+              be called for this one).
+*/
+/**************************************************************************/
+bool Adafruit_GFX::pushClip(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if (_clipDepth >= GFX_CLIP_STACK_DEPTH)
+    return false;
+  GFXclip c = _clipStack[_clipDepth++] = _clip;
+  setClipRect(x, y, w, h);
+  if (_clip.x0 < c.x0)
+    _clip.x0 = c.x0;
+  if (_clip.y0 < c.y0)
+    _clip.y0 = c.y0;
+  if (_clip.x1 > c.x1)
+    _clip.x1 = c.x1;
+  if (_clip.y1 > c.y1)
+    _clip.y1 = c.y1;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Restore the clip rectangle saved by the last pushClip(). If none
+            is saved, the clip is removed.
+*/
+/**************************************************************************/
+void Adafruit_GFX::popClip(void) {
+  if (_clipDepth) {
+    _clip = _clipStack[--_clipDepth];
+    _clipActive = (_clip.x0 != -0x7FFF - 1) || (_clip.y0 != -0x7FFF - 1) ||
+                  (_clip.x1 != 0x7FFF) || (_clip.y1 != 0x7FFF);
+  } else {
+    resetClipRect();
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Get the area drawing is currently limited to: the clip
+            rectangle, within the display bounds. With no clip set, this is
+            the whole display.
+    @param  x  Pointer to returned left edge
+    @param  y  Pointer to returned top edge
+    @param  w  Pointer to returned width (0 if nothing can be drawn)
+    @param  h  Pointer to returned height (0 if nothing can be drawn)
+*/
+/**************************************************************************/
+void Adafruit_GFX::getClipRect(int16_t *x, int16_t *y, int16_t *w,
+                               int16_t *h) const {
+  int16_t x0 = (_clip.x0 > 0) ? _clip.x0 : 0;
+  int16_t y0 = (_clip.y0 > 0) ? _clip.y0 : 0;
+  int16_t x1 = (_clip.x1 < _width - 1) ? _clip.x1 : _width - 1;
+  int16_t y1 = (_clip.y1 < _height - 1) ? _clip.y1 : _height - 1;
+  if ((x1 < x0) || (y1 < y0)) {
+    x1 = x0 - 1; // Empty
+    y1 = y0 - 1;
+  }
+  *x = x0;
+  *y = y0;
+  *w = x1 - x0 + 1;
+  *h = y1 - y0 + 1;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Clip a rectangle to the clip rectangle (NOT to the display,
+            which is left to the caller's existing checks). For subclasses
+            overriding the drawing functions, typically used as
+            "if (_clipActive && !clipRect(x, y, w, h)) return;"
+    @param  x  Left edge, updated upon return
+    @param  y  Top edge, updated upon return
+    @param  w  Width, may be negative (extends left of x), positive upon
+               return
+    @param  h  Height, may be negative (extends above y), positive upon
+               return
+    @returns  false if nothing is left to draw
+*/
+/**************************************************************************/
+bool Adafruit_GFX::clipRect(int16_t &x, int16_t &y, int16_t &w,
+                            int16_t &h) const {
+  int32_t x0 = x, y0 = y, x1, y1;
+  if (w < 0)
+    x0 += w + 1;
+  if (h < 0)
+    y0 += h + 1;
+  x1 = x0 + abs(w) - 1;
+  y1 = y0 + abs(h) - 1;
+  if (x0 < _clip.x0)
+    x0 = _clip.x0;
+  if (y0 < _clip.y0)
+    y0 = _clip.y0;
+  if (x1 > _clip.x1)
+    x1 = _clip.x1;
+  if (y1 > _clip.y1)
+    y1 = _clip.y1;
+  if ((x0 > x1) || (y0 > y1))
+    return false;
+  x = x0;
+  y = y0;
+  w = x1 - x0 + 1;
+  h = y1 - y0 + 1;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Narrow a range of columns to those within both the display and
+            the clip rectangle.
+    @param  x0  First column, updated upon return
+    @param  x1  Last column, updated upon return (less than x0 if none left)
+*/
+/**************************************************************************/
+void Adafruit_GFX::clipColumns(int16_t &x0, int16_t &x1) const {
+  int16_t left = (_clip.x0 > 0) ? _clip.x0 : 0;
+  int16_t right = (_clip.x1 < _width - 1) ? _clip.x1 : _width - 1;
+  if (x0 < left)
+    x0 = left;
+  if (x1 > right)
+    x1 = right;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Narrow a range of rows to those within both the display and the
+            clip rectangle, so filled shapes can skip the rest entirely.
+    @param  y0  First row, updated upon return
+    @param  y1  Last row, updated upon return (less than y0 if none left)
+*/
+/**************************************************************************/
+void Adafruit_GFX::clipRows(int16_t &y0, int16_t &y1) const {
+  int16_t top = (_clip.y0 > 0) ? _clip.y0 : 0;
+  int16_t bottom = (_clip.y1 < _height - 1) ? _clip.y1 : _height - 1;
+  if (y0 < top)
+    y0 = top;
+  if (y1 > bottom)
+    y1 = bottom;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Clip a filled rectangle to both the display and the clip
+            rectangle, for subclasses drawing rectangles directly into
+            their own memory.
+    @param  x  Left edge, updated upon return
+    @param  y  Top edge, updated upon return
+    @param  w  Width, may be negative (extends left of x), positive upon
+               return
+    @param  h  Height, may be negative (extends above y), positive upon
+               return
+    @returns  false if nothing is left to draw
+*/
+/**************************************************************************/
+bool Adafruit_GFX::clipFillRect(int16_t &x, int16_t &y, int16_t &w,
+                                int16_t &h) const {
+  int32_t x0 = x, y0 = y;
+  if (w < 0)
+    x0 += w + 1;
+  if (h < 0)
+    y0 += h + 1;
+  int32_t x1 = x0 + abs(w) - 1, y1 = y0 + abs(h) - 1;
+  int16_t cx0 = (x0 < -0x7FFF) ? -0x7FFF : x0; // Back into 16 bits
+  int16_t cy0 = (y0 < -0x7FFF) ? -0x7FFF : y0;
+  int16_t cx1 = (x1 > 0x7FFF) ? 0x7FFF : x1;
+  int16_t cy1 = (y1 > 0x7FFF) ? 0x7FFF : y1;
+  clipColumns(cx0, cx1);
+  clipRows(cy0, cy1);
+  if (!w || !h || (cx0 > cx1) || (cy0 > cy1))
+    return false;
+  x = cx0;
+  y = cy0;
+  w = cx1 - cx0 + 1;
+  h = cy1 - cy0 + 1;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Convert a rectangle (already clipped to the display) from
+            rotated to raw (rotation 0) coordinates, for subclasses with
+            a framebuffer in raw order.
+    @param  x  Left edge, updated upon return
+    @param  y  Top edge, updated upon return
+    @param  w  Width, updated upon return
+    @param  h  Height, updated upon return
+*/
+/**************************************************************************/
+void Adafruit_GFX::rotateRect(int16_t &x, int16_t &y, int16_t &w,
+                              int16_t &h) const {
+  int16_t t;
+  switch (rotation) {
+  case 1:
+    t = x;
+    x = WIDTH - y - h;
+    y = t;
+    t = w;
+    w = h;
+    h = t;
+    break;
+  case 2:
+    x = WIDTH - x - w;
+    y = HEIGHT - y - h;
+    break;
+  case 3:
+    t = y;
+    y = HEIGHT - x - w;
+    x = t;
+    t = w;
+    w = h;
+    h = t;
+    break;
+  }
 }
 
 /**************************************************************************/
@@ -1605,6 +2843,21 @@ void Adafruit_GFX::setFont(const GFXfont *f) {
     cursor_y -= 6;
   }
   gfxFont = (GFXfont *)f;
+  gfxFont2 = NULL;
+  prevChar = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief Set a version 2 font (kerning, compressed bitmaps, large fonts)
+           to display when print()ing. Use setFont(NULL) to go back to
+           the built-in font.
+    @param  f  The GFXfont2 object
+*/
+/**************************************************************************/
+void Adafruit_GFX::setFont(const GFXfont2 &f) {
+  setFont(&f.font);
+  gfxFont2 = &f;
 }
 
 /**************************************************************************/
@@ -1705,29 +2958,16 @@ void Adafruit_GFX::charBounds(unsigned char c, int16_t *x, int16_t *y,
 void Adafruit_GFX::getTextBounds(const char *str, int16_t x, int16_t y,
                                  int16_t *x1, int16_t *y1, uint16_t *w,
                                  uint16_t *h) {
-
-  uint8_t c; // Current character
   int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1; // Bound rect
   // Bound rect is intentionally initialized inverted, so 1st char sets it
-
-  *x1 = x; // Initial position is value passed in
-  *y1 = y;
-  *w = *h = 0; // Initial size is zero
-
-  while ((c = *str++)) {
-    // charBounds() modifies x/y to advance for each character,
-    // and min/max x/y are updated to incrementally build bounding rect.
-    charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
-  }
-
-  if (maxx >= minx) {     // If legit string bounds were found...
-    *x1 = minx;           // Update x1 to least X coord,
-    *w = maxx - minx + 1; // And w to bound rect width
-  }
-  if (maxy >= miny) { // Same for height
-    *y1 = miny;
-    *h = maxy - miny + 1;
-  }
+  int16_t x0 = x, y0 = y;
+  uint8_t prev = 0;
+
+  // layoutText() modifies x/y to advance for each character,
+  // and min/max x/y are updated to incrementally build bounding rect.
+  layoutText(str, (size_t)-1, false, false, &x, &y, &prev, &minx, &miny,
+             &maxx, &maxy);
+  textBounds(x0, y0, minx, miny, maxx, maxy, x1, y1, w, h);
 }
 
 /**************************************************************************/
@@ -1767,25 +3007,375 @@ void Adafruit_GFX::getTextBounds(const String &str, int16_t x, int16_t y,
 void Adafruit_GFX::getTextBounds(const __FlashStringHelper *str, int16_t x,
                                  int16_t y, int16_t *x1, int16_t *y1,
                                  uint16_t *w, uint16_t *h) {
-  uint8_t *s = (uint8_t *)str, c;
+  int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1;
+  int16_t x0 = x, y0 = y;
+  uint8_t prev = 0;
+
+  layoutText((const char *)str, (size_t)-1, true, false, &x, &y, &prev, &minx,
+             &miny, &maxx, &maxy);
+  textBounds(x0, y0, minx, miny, maxx, maxy, x1, y1, w, h);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Advance text layout by one character, exactly as print() moves
+            the cursor (newlines, wrapping and all). This is the one place
+            text layout is worked out: print(), drawString(), measuring with
+            getTextBounds() and drawOpaqueText() all use it.
+    @param  c   The character
+    @param  x   Pointer to layout x position, updated upon return
+    @param  y   Pointer to layout y position, updated upon return
+    @param  gx  Pointer to returned x origin of the glyph, for drawChar()
+    @param  gy  Pointer to returned y origin of the glyph, for drawChar()
+    @param  bx  Pointer to returned left edge of glyph's box
+    @param  by  Pointer to returned top edge of glyph's box
+    @param  bw  Pointer to returned box width, 0 if there's nothing to draw
+    @param  bh  Pointer to returned box height, 0 if there's nothing to draw
+    @param  prev  Pointer to previous char (0 if none) for kerning, updated
+                  upon return
+    @returns  true if the character has a glyph (even a blank one), false
+              if it only moves the position or isn't in the font
+*/
+/**************************************************************************/
+bool Adafruit_GFX::layoutChar(unsigned char c, int16_t *x, int16_t *y,
+                              int16_t *gx, int16_t *gy, int16_t *bx,
+                              int16_t *by, int16_t *bw, int16_t *bh,
+                              uint8_t *prev) {
+  uint8_t left = *prev;
+
+  *prev = 0;      // Unless this turns out to be a glyph
+  if (!gfxFont) { // 'Classic' built-in font
+
+    if (c == '\n') {                                  // Newline?
+      *x = 0;                                         // Reset x to zero,
+      *y += textsize_y * 8;                           // advance y one line
+    } else if (c != '\r') {                           // Ignore carriage returns
+      if (wrap && ((*x + textsize_x * 6) > _width)) { // Off right?
+        *x = 0;                                       // Reset x to zero,
+        *y += textsize_y * 8;                         // advance y one line
+      }
+      *gx = *bx = *x;
+      *gy = *by = *y;
+      *bw = textsize_x * 6;
+      *bh = textsize_y * 8;
+      *x += textsize_x * 6; // Advance x one char
+      *prev = c;
+      return true;
+    }
+
+  } else { // Custom font
+
+    if (c == '\n') {
+      *x = 0;
+      *y += (int16_t)textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+    } else if (c != '\r') {
+      uint8_t first = pgm_read_byte(&gfxFont->first);
+      if ((c >= first) && (c <= (uint8_t)pgm_read_byte(&gfxFont->last))) {
+        GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c - first);
+        uint8_t w = pgm_read_byte(&glyph->width),
+                h = pgm_read_byte(&glyph->height);
+        int16_t xo = (int8_t)pgm_read_byte(&glyph->xOffset); // sic
+        int16_t tsx = (int16_t)textsize_x, tsy = (int16_t)textsize_y;
+        if (left)
+          *x += kernPair(gfxFont2, left, c) * tsx;
+        if ((w > 0) && (h > 0)) { // Is there an associated bitmap?
+          if (wrap && ((*x + textsize_x * (xo + w)) > _width)) {
+            *x = 0;
+            *y += tsy * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+          }
+        }
+        *gx = *x;
+        *gy = *y;
+        *bx = *x + xo * tsx;
+        *by = *y + (int8_t)pgm_read_byte(&glyph->yOffset) * tsy;
+        *bw = w * tsx;
+        *bh = h * tsy;
+        *x += (uint8_t)pgm_read_byte(&glyph->xAdvance) * tsx;
+        *prev = c;
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Lay out (and optionally draw) a string in a single pass,
+            starting at and updating a layout position. Glyphs are drawn
+            with the write functions, so the caller must wrap this in
+            startWrite()/endWrite().
+    @param  str    String
+    @param  len    Max number of characters, stops early at a NUL
+    @param  flash  true if str is in PROGMEM
+    @param  draw   true to draw glyphs, false to only measure
+    @param  x      Pointer to layout x position, updated upon return
+    @param  y      Pointer to layout y position, updated upon return
+    @param  prev   Pointer to previous char (0 if none) for kerning, updated
+                   upon return
+    @param  minx   Pointer to min x of bounds, updated upon return. If NULL
+                   (and maxx etc.), bounds aren't tracked, and drawing (but
+                   not layout) stops once the position has moved past the
+                   bottom of the display or clip rectangle.
+    @param  miny   Pointer to min y of bounds, updated upon return
+    @param  maxx   Pointer to max x of bounds, updated upon return
+    @param  maxy   Pointer to max y of bounds, updated upon return
+    @returns  Number of characters processed
+*/
+/**************************************************************************/
+size_t Adafruit_GFX::layoutText(const char *str, size_t len, bool flash,
+                                bool draw, int16_t *x, int16_t *y,
+                                uint8_t *prev, int16_t *minx, int16_t *miny,
+                                int16_t *maxx, int16_t *maxy) {
+  int16_t gx, gy, bx, by, bw, bh, top = 0, bottom = _height - 1;
+  int16_t reach = gfxFont ? 128 * textsize_y : 0; // Max glyph rise
+  size_t n;
+  uint8_t c;
+
+  clipRows(top, bottom);
+  for (n = 0; n < len; n++) {
+    if (!(c = flash ? pgm_read_byte(&str[n]) : str[n]))
+      break;
+    if (!layoutChar(c, x, y, &gx, &gy, &bx, &by, &bw, &bh, prev))
+      continue;
+    if (minx) {
+      // Blank glyphs count toward bounds too, as in charBounds()
+      if (bx < *minx)
+        *minx = bx;
+      if (by < *miny)
+        *miny = by;
+      if (bx + bw - 1 > *maxx)
+        *maxx = bx + bw - 1;
+      if (by + bh - 1 > *maxy)
+        *maxy = by + bh - 1;
+    } else if (*y - reach > bottom) {
+      draw = false; // Lines only move down, nothing more can be visible
+    }
+    if (draw && bw && bh)
+      writeChar(gx, gy, c, textcolor, textbgcolor, textsize_x, textsize_y);
+  }
+  return n;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a string at the cursor, like print() but in one go: the
+            string is laid out in a single pass (advance, wrap, newlines),
+            and all glyphs are drawn within a single transaction. Nothing
+            more is drawn once the text has moved below the display (or clip
+            rectangle), but the rest is still laid out, so the cursor ends up
+            where print() would leave it. Optionally also returns the bounds
+            of the string, as getTextBounds() would, from the same pass.
+    @param  str  String
+    @param  len  Number of characters to draw, stops early at a NUL
+    @param  x1   Pointer to returned left edge of bounds, or NULL
+    @param  y1   Pointer to returned top edge of bounds, or NULL
+    @param  w    Pointer to returned width of bounds, or NULL
+    @param  h    Pointer to returned height of bounds, or NULL
+    @returns  Number of characters processed
+*/
+/**************************************************************************/
+size_t Adafruit_GFX::drawString(const char *str, size_t len, int16_t *x1,
+                                int16_t *y1, uint16_t *w, uint16_t *h) {
+  int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1; // Bound rect
+  int16_t x = cursor_x, y = cursor_y;
+  bool bounds = x1 && y1 && w && h;
+  size_t n;
+
+  startWrite();
+  n = layoutText(str, len, false, true, &cursor_x, &cursor_y, &prevChar,
+                 bounds ? &minx : NULL, &miny, &maxx, &maxy);
+  endWrite();
+
+  if (bounds)
+    textBounds(x, y, minx, miny, maxx, maxy, x1, y1, w, h);
+  return n;
+}
 
-  *x1 = x;
+/**************************************************************************/
+/*!
+    @brief  Convert min/max bounds from layoutText() into getTextBounds()
+            results
+    @param  x     Starting x position, result if nothing was found
+    @param  y     Starting y position, result if nothing was found
+    @param  minx  Least x found
+    @param  miny  Least y found
+    @param  maxx  Greatest x found
+    @param  maxy  Greatest y found
+    @param  x1    Pointer to returned left edge
+    @param  y1    Pointer to returned top edge
+    @param  w     Pointer to returned width
+    @param  h     Pointer to returned height
+*/
+/**************************************************************************/
+void Adafruit_GFX::textBounds(int16_t x, int16_t y, int16_t minx, int16_t miny,
+                              int16_t maxx, int16_t maxy, int16_t *x1,
+                              int16_t *y1, uint16_t *w, uint16_t *h) {
+  *x1 = x; // Initial position is value passed in
   *y1 = y;
-  *w = *h = 0;
+  *w = *h = 0; // Initial size is zero
+
+  if (maxx >= minx) {     // If legit string bounds were found...
+    *x1 = minx;           // Update x1 to least X coord,
+    *w = maxx - minx + 1; // And w to bound rect width
+  }
+  if (maxy >= miny) { // Same for height
+    *y1 = miny;
+    *h = maxy - miny + 1;
+  }
+}
 
-  int16_t minx = _width, miny = _height, maxx = -1, maxy = -1;
+/**************************************************************************/
+/*!
+    @brief  Find the area drawOpaqueText() would fill, i.e. the bounding box
+            of all the glyphs (full character cells with the classic font),
+            narrowed to the display and clip rectangle.
+    @param  x    Starting x position, as with setCursor()
+    @param  y    Starting y position, as with setCursor()
+    @param  str  Null-terminated string
+    @param  x1   Pointer to returned left edge
+    @param  y1   Pointer to returned top edge
+    @param  x2   Pointer to returned right edge (inclusive)
+    @param  y2   Pointer to returned bottom edge (inclusive)
+    @returns  false if nothing would be visible
+*/
+/**************************************************************************/
+bool Adafruit_GFX::opaqueTextBox(int16_t x, int16_t y, const char *str,
+                                 int16_t *x1, int16_t *y1, int16_t *x2,
+                                 int16_t *y2) {
+  int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -0x7FFF - 1, maxy = -0x7FFF - 1;
+  int16_t gx, gy, bx, by, bw, bh;
+  uint8_t c, prev = 0;
+
+  while ((c = *str++)) {
+    if (!layoutChar(c, &x, &y, &gx, &gy, &bx, &by, &bw, &bh, &prev) || !bw ||
+        !bh)
+      continue;
+    if (bx < minx)
+      minx = bx;
+    if (by < miny)
+      miny = by;
+    if (bx + bw - 1 > maxx)
+      maxx = bx + bw - 1;
+    if (by + bh - 1 > maxy)
+      maxy = by + bh - 1;
+  }
+
+  clipColumns(minx, maxx);
+  clipRows(miny, maxy);
+  *x1 = minx;
+  *y1 = miny;
+  *x2 = maxx;
+  *y2 = maxy;
+  return (minx <= maxx) && (miny <= maxy);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Compose one row of text as a 1-bit mask: bits are set wherever
+            any glyph has a pixel, so overlapping glyphs combine correctly.
+    @param  x     Starting x position, as with setCursor()
+    @param  y     Starting y position, as with setCursor()
+    @param  str   Null-terminated string
+    @param  row   Display row to compose
+    @param  x0    Display column of first mask bit
+    @param  w     Number of mask bits (columns)
+    @param  mask  Buffer of at least (w + 7) / 8 bytes, MSB is leftmost
+*/
+/**************************************************************************/
+void Adafruit_GFX::opaqueTextRow(int16_t x, int16_t y, const char *str,
+                                 int16_t row, int16_t x0, int16_t w,
+                                 uint8_t *mask) {
+  int16_t gx, gy, bx, by, bw, bh, px;
+  uint8_t c, xx, yy, gw, i, prev = 0;
+
+  memset(mask, 0, (w + 7) / 8);
+
+  while ((c = *str++)) {
+    if (!layoutChar(c, &x, &y, &gx, &gy, &bx, &by, &bw, &bh, &prev) || !bw ||
+        !bh || (row < by) || (row >= by + bh))
+      continue; // Nothing on this row
+    yy = (row - by) / textsize_y;
+    if (gfxFont) {
+      GFXglyphBits bits;
+      c -= (uint8_t)pgm_read_byte(&gfxFont->first);
+      gw = pgm_read_byte(&pgm_read_glyph_ptr(gfxFont, c)->width);
+      glyphBitsBegin(&bits, gfxFont, gfxFont2, c);
+      glyphBitsSkip(&bits, yy * gw);
+      for (xx = 0; xx < gw; xx++) {
+        if (glyphBitsNext(&bits)) {
+          px = bx + xx * textsize_x - x0;
+          for (i = 0; i < textsize_x; i++, px++) {
+            if ((px >= 0) && (px < w))
+              mask[px >> 3] |= 0x80 >> (px & 7);
+          }
+        }
+      }
+    } else {
+      if (!_cp437 && (c >= 176))
+        c++; // Handle 'classic' charset behavior
+
+      for (xx = 0; xx < 5; xx++) { // Char bitmap = 5 columns
+        if (pgm_read_byte(&font[c * 5 + xx]) & (1 << yy)) {
+          px = bx + xx * textsize_x - x0;
+          for (i = 0; i < textsize_x; i++, px++) {
+            if ((px >= 0) && (px < w))
+              mask[px >> 3] |= 0x80 >> (px & 7);
+          }
+        }
+      }
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a string with a solid background, with any font. The whole
+            string is composed one row at a time, then each pixel of its
+            bounding box is written exactly once, in either the text or the
+            background color. This is the flicker-free way to update text
+            in place (e.g. changing numbers), as nothing is erased first,
+            and unlike drawChar() backgrounds, works with the proportional,
+            overlapping glyphs of custom fonts: it's equivalent to printing
+            into a GFXcanvas1 and drawing that with drawBitmap() and a
+            background color, without the canvas's RAM. Text size, wrap and
+            font are those set for print(). The cursor is not moved. Needs
+            (width + 7) / 8 bytes of temporary heap; nothing is drawn if
+            that can't be allocated.
+    @param  x      Starting x position, as with setCursor()
+    @param  y      Starting y position, as with setCursor() (the baseline,
+                   with custom fonts)
+    @param  str    Null-terminated string
+    @param  color  16-bit 5-6-5 Color to draw text with
+    @param  bg     16-bit 5-6-5 Color to draw background with
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawOpaqueText(int16_t x, int16_t y, const char *str,
+                                  uint16_t color, uint16_t bg) {
+  int16_t x1, y1, x2, y2, row, a, b, w;
+  uint8_t *mask;
 
-  while ((c = pgm_read_byte(s++)))
-    charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+  if (!opaqueTextBox(x, y, str, &x1, &y1, &x2, &y2))
+    return;
+  w = x2 - x1 + 1;
+  if (!(mask = (uint8_t *)malloc((w + 7) / 8)))
+    return;
 
-  if (maxx >= minx) {
-    *x1 = minx;
-    *w = maxx - minx + 1;
-  }
-  if (maxy >= miny) {
-    *y1 = miny;
-    *h = maxy - miny + 1;
+  startWrite();
+  for (row = y1; row <= y2; row++) {
+    opaqueTextRow(x, y, str, row, x1, w, mask);
+    for (a = 0; a < w; a = b) { // Alternating runs of text & background
+      bool on = mask[a >> 3] & (0x80 >> (a & 7));
+      for (b = a + 1;
+           (b < w) && (!(mask[b >> 3] & (0x80 >> (b & 7))) == !on); b++)
+        ;
+      writeFastHLine(x1 + a, row, b - a, on ? color : bg);
+    }
   }
+  endWrite();
+
+  free(mask);
 }
 
 /**************************************************************************/
@@ -2002,12 +3592,215 @@ bool Adafruit_GFX_Button::justReleased() { return (!currstate && laststate); }
 // scanline pad).
 // NOT EXTENSIVELY TESTED YET.  MAY CONTAIN WORST BUGS KNOWN TO HUMANKIND.
 
+// Buffer index of pixel (0, 0) and index steps for x+1 and y+1, for a raw
+// canvas buffer of w x h pixels with 'pitch' indices per row, at a given
+// rotation. Pixel (x, y) is then at origin + x * xStep + y * yStep, and
+// loops can walk the buffer by adding steps instead of rotating each pixel.
+static void canvasSteps(uint8_t rotation, int16_t w, int16_t h, int32_t pitch,
+                        int32_t *origin, int32_t *xStep, int32_t *yStep) {
+  switch (rotation) {
+  case 0:
+    *origin = 0;
+    *xStep = 1;
+    *yStep = pitch;
+    break;
+  case 1:
+    *origin = w - 1;
+    *xStep = pitch;
+    *yStep = -1;
+    break;
+  case 2:
+    *origin = (w - 1) + (h - 1) * pitch;
+    *xStep = -1;
+    *yStep = -pitch;
+    break;
+  case 3:
+    *origin = (h - 1) * pitch;
+    *xStep = -pitch;
+    *yStep = 1;
+    break;
+  }
+}
+
+// Steps through the pixels of a line exactly as Adafruit_GFX::writeLine()
+// does (Bresenham), moving a canvas buffer index along with x and y.
+typedef struct {
+  int16_t x, y;        // Current pixel
+  int16_t dx, dy, err; // Bresenham terms along major & minor axis
+  int16_t n;           // Pixels left after current one
+  int8_t mx, my;       // x & y change for a major axis step
+  int8_t nx, ny;       // x & y change for a minor axis step
+  int32_t index;       // Buffer index of current pixel
+  int32_t mi, ni;      // Buffer index change for major & minor steps
+} GFXlineWalk;
+
+static void lineWalkBegin(GFXlineWalk *l, int16_t x0, int16_t y0, int16_t x1,
+                          int16_t y1, int32_t origin, int32_t xStep,
+                          int32_t yStep) {
+  bool steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep ? (y0 > y1) : (x0 > x1)) { // Always walk forward on major axis
+    _swap_int16_t(x0, x1);
+    _swap_int16_t(y0, y1);
+  }
+  int8_t step = (steep ? (x0 < x1) : (y0 < y1)) ? 1 : -1;
+  l->x = x0;
+  l->y = y0;
+  l->dx = steep ? y1 - y0 : x1 - x0;
+  l->dy = steep ? abs(x1 - x0) : abs(y1 - y0);
+  l->err = l->dx / 2;
+  l->n = l->dx;
+  l->mx = !steep;
+  l->my = steep;
+  l->nx = steep ? step : 0;
+  l->ny = steep ? 0 : step;
+  l->index = origin + (int32_t)x0 * xStep + (int32_t)y0 * yStep;
+  l->mi = steep ? yStep : xStep;
+  l->ni = step * (steep ? xStep : yStep);
+}
+
+static inline bool lineWalkNext(GFXlineWalk *l) {
+  if (!l->n--)
+    return false;
+  l->err -= l->dy;
+  if (l->err < 0) {
+    l->x += l->nx;
+    l->y += l->ny;
+    l->index += l->ni;
+    l->err += l->dx;
+  }
+  l->x += l->mx;
+  l->y += l->my;
+  l->index += l->mi;
+  return true;
+}
+
+// Canvas dirty area, kept as a box of inclusive corners in rotated (user)
+// coordinates like the clip rectangle, empty if x1 < x0.
+static void dirtyClear(GFXclip *d) {
+  d->x0 = d->y0 = 0x7FFF;
+  d->x1 = d->y1 = -1;
+}
+
+static inline void dirtyPoint(GFXclip *d, int16_t x, int16_t y) {
+  if (x < d->x0)
+    d->x0 = x;
+  if (x > d->x1)
+    d->x1 = x;
+  if (y < d->y0)
+    d->y0 = y;
+  if (y > d->y1)
+    d->y1 = y;
+}
+
+// Rectangle must already be clipped to the canvas
+static void dirtyRect(GFXclip *d, int16_t x, int16_t y, int16_t w, int16_t h) {
+  if ((w > 0) && (h > 0)) {
+    dirtyPoint(d, x, y);
+    dirtyPoint(d, x + w - 1, y + h - 1);
+  }
+}
+
+// Bounding box of a line, within the columns & rows it may be drawn in
+static void dirtyLine(GFXclip *d, int16_t x0, int16_t y0, int16_t x1,
+                      int16_t y1, int16_t cx0, int16_t cy0, int16_t cx1,
+                      int16_t cy1) {
+  if (x0 > x1)
+    _swap_int16_t(x0, x1);
+  if (y0 > y1)
+    _swap_int16_t(y0, y1);
+  if (x0 < cx0)
+    x0 = cx0;
+  if (y0 < cy0)
+    y0 = cy0;
+  if (x1 > cx1)
+    x1 = cx1;
+  if (y1 > cy1)
+    y1 = cy1;
+  if ((x0 <= x1) && (y0 <= y1)) {
+    dirtyPoint(d, x0, y0);
+    dirtyPoint(d, x1, y1);
+  }
+}
+
+// Move the box from one rotation to another, via raw (rotation 0)
+// coordinates, for a canvas of w x h raw pixels
+static void dirtyRotate(GFXclip *d, uint8_t from, uint8_t to, int16_t w,
+                        int16_t h) {
+  if ((d->x1 < d->x0) || (from == to))
+    return;
+  int16_t x0 = d->x0, y0 = d->y0, x1 = d->x1, y1 = d->y1;
+  switch (from) {
+  case 1:
+    x0 = w - 1 - d->y1;
+    y0 = d->x0;
+    x1 = w - 1 - d->y0;
+    y1 = d->x1;
+    break;
+  case 2:
+    x0 = w - 1 - d->x1;
+    y0 = h - 1 - d->y1;
+    x1 = w - 1 - d->x0;
+    y1 = h - 1 - d->y0;
+    break;
+  case 3:
+    x0 = d->y0;
+    y0 = h - 1 - d->x1;
+    x1 = d->y1;
+    y1 = h - 1 - d->x0;
+    break;
+  }
+  switch (to) {
+  case 0:
+    d->x0 = x0;
+    d->y0 = y0;
+    d->x1 = x1;
+    d->y1 = y1;
+    break;
+  case 1:
+    d->x0 = y0;
+    d->y0 = w - 1 - x1;
+    d->x1 = y1;
+    d->y1 = w - 1 - x0;
+    break;
+  case 2:
+    d->x0 = w - 1 - x1;
+    d->y0 = h - 1 - y1;
+    d->x1 = w - 1 - x0;
+    d->y1 = h - 1 - y0;
+    break;
+  case 3:
+    d->x0 = h - 1 - y1;
+    d->y0 = x0;
+    d->x1 = h - 1 - y0;
+    d->y1 = x1;
+    break;
+  }
+}
+
+// Report the box as a rectangle, false if nothing's been drawn
+static bool dirtyGet(const GFXclip *d, int16_t *x, int16_t *y, int16_t *w,
+                     int16_t *h) {
+  bool dirty = (d->x1 >= d->x0);
+  if (x)
+    *x = dirty ? d->x0 : 0;
+  if (y)
+    *y = dirty ? d->y0 : 0;
+  if (w)
+    *w = dirty ? d->x1 - d->x0 + 1 : 0;
+  if (h)
+    *h = dirty ? d->y1 - d->y0 + 1 : 0;
+  return dirty;
+}
+
 #ifdef __AVR__
 // Bitmask tables of 0x80>>X and ~(0x80>>X), because X>>Y is slow on AVR
 const uint8_t PROGMEM GFXcanvas1::GFXsetBit[] = {0x80, 0x40, 0x20, 0x10,
                                                  0x08, 0x04, 0x02, 0x01};
 const uint8_t PROGMEM GFXcanvas1::GFXclrBit[] = {0x7F, 0xBF, 0xDF, 0xEF,
                                                  0xF7, 0xFB, 0xFD, 0xFE};
+// And of 0xFF>>X, for masks of runs of bits within a byte
+const uint8_t PROGMEM GFXcanvas1::GFXrunMask[] = {
+    0xFF, 0x7F, 0x3F, 0x1F, 0x0F, 0x07, 0x03, 0x01, 0x00};
 #endif
 
 /**************************************************************************/
@@ -2023,6 +3816,9 @@ const uint8_t PROGMEM GFXcanvas1::GFXclrBit[] = {0x7F, 0xBF, 0xDF, 0xEF,
 /**************************************************************************/
 GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h, bool allocate_buffer)
     : Adafruit_GFX(w, h), buffer_owned(allocate_buffer) {
+  dirtyClear(&_dirty);
+  canvasSteps(0, w, h, ((w + 7) / 8) * 8, &_pixelOrigin, &_pixelXStep,
+              &_pixelYStep);
   if (allocate_buffer) {
     uint32_t bytes = ((w + 7) / 8) * h;
     if ((buffer = (uint8_t *)malloc(bytes))) {
@@ -2053,39 +3849,13 @@ GFXcanvas1::~GFXcanvas1(void) {
 /**************************************************************************/
 void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
   if (buffer) {
-    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height) ||
+        !inClip(x, y))
       return;
 
-    int16_t t;
-    switch (rotation) {
-    case 1:
-      t = x;
-      x = WIDTH - 1 - y;
-      y = t;
-      break;
-    case 2:
-      x = WIDTH - 1 - x;
-      y = HEIGHT - 1 - y;
-      break;
-    case 3:
-      t = x;
-      x = y;
-      y = HEIGHT - 1 - t;
-      break;
-    }
-
-    uint8_t *ptr = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
-#ifdef __AVR__
-    if (color)
-      *ptr |= pgm_read_byte(&GFXsetBit[x & 7]);
-    else
-      *ptr &= pgm_read_byte(&GFXclrBit[x & 7]);
-#else
-    if (color)
-      *ptr |= 0x80 >> (x & 7);
-    else
-      *ptr &= ~(0x80 >> (x & 7));
-#endif
+    dirtyPoint(&_dirty, x, y);
+    // Bit index of pixel, rotated by the steps set in setRotation()
+    writeBit(_pixelOrigin + x * _pixelXStep + y * _pixelYStep, color);
   }
 }
 
@@ -2099,26 +3869,37 @@ void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
 */
 /**********************************************************************/
 bool GFXcanvas1::getPixel(int16_t x, int16_t y) const {
-  int16_t t;
-  switch (rotation) {
-  case 1:
-    t = x;
-    x = WIDTH - 1 - y;
-    y = t;
-    break;
-  case 2:
-    x = WIDTH - 1 - x;
-    y = HEIGHT - 1 - y;
-    break;
-  case 3:
-    t = x;
-    x = y;
-    y = HEIGHT - 1 - t;
-    break;
-  }
-  return getRawPixel(x, y);
+  if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height) || !buffer)
+    return 0;
+  return readBit(_pixelOrigin + x * _pixelXStep + y * _pixelYStep);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Get the area changed by drawing since the last
+            clearDirtyRect() (or since the canvas was made), so only that
+            part of the buffer needs sending to a display. Any of the
+            pointers may be NULL.
+    @param  x  Left edge of area, in current rotation's coordinates
+    @param  y  Top edge of area
+    @param  w  Width of area, 0 if nothing has changed
+    @param  h  Height of area, 0 if nothing has changed
+    @returns  true if anything has changed
+*/
+/**************************************************************************/
+bool GFXcanvas1::getDirtyRect(int16_t *x, int16_t *y, int16_t *w,
+                              int16_t *h) const {
+  return dirtyGet(&_dirty, x, y, w, h);
 }
 
+/**************************************************************************/
+/*!
+    @brief  Mark the whole canvas unchanged, e.g. after sending the dirty
+            area to a display
+*/
+/**************************************************************************/
+void GFXcanvas1::clearDirtyRect(void) { dirtyClear(&_dirty); }
+
 /**********************************************************************/
 /*!
         @brief    Get the pixel color value at a given, unrotated coordinate.
@@ -2152,12 +3933,233 @@ bool GFXcanvas1::getRawPixel(int16_t x, int16_t y) const {
 */
 /**************************************************************************/
 void GFXcanvas1::fillScreen(uint16_t color) {
-  if (buffer) {
+  if (_clipActive) {
+    fillRect(0, 0, _width, _height, color); // Only within clip rectangle
+  } else if (buffer) {
+    dirtyRect(&_dirty, 0, 0, _width, _height);
     uint32_t bytes = ((WIDTH + 7) / 8) * HEIGHT;
     memset(buffer, color ? 0xFF : 0x00, bytes);
   }
 }
 
+/**************************************************************************/
+/*!
+   @brief    Fill a rectangle directly in the canvas buffer, a row at a time
+   @param    x   Top left corner x coordinate
+   @param    y   Top left corner y coordinate
+   @param    w   Width in pixels
+   @param    h   Height in pixels
+   @param    color   Binary (on or off) color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                          uint16_t color) {
+  // Negative widths draw nothing, as with Adafruit_GFX::fillRect()
+  if (!buffer || (w < 1) || !clipFillRect(x, y, w, h))
+    return;
+  dirtyRect(&_dirty, x, y, w, h);
+  rotateRect(x, y, w, h); // Once for the whole rect, not per pixel
+  while (h--)
+    drawFastRawHLine(x, y++, w, color);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set rotation setting for display, and the buffer steps used to
+            draw into the canvas at that rotation
+    @param  r  0 thru 3 corresponding to 4 cardinal rotations
+*/
+/**************************************************************************/
+void GFXcanvas1::setRotation(uint8_t r) {
+  dirtyRotate(&_dirty, rotation, r & 3, WIDTH, HEIGHT);
+  Adafruit_GFX::setRotation(r);
+  canvasSteps(rotation, WIDTH, HEIGHT, ((WIDTH + 7) / 8) * 8, &_pixelOrigin,
+              &_pixelXStep, &_pixelYStep);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw a line directly into the canvas buffer, stepping the buffer
+             index along with the line instead of rotating every pixel
+    @param    x0  Start point x coordinate
+    @param    y0  Start point y coordinate
+    @param    x1  End point x coordinate
+    @param    y1  End point y coordinate
+    @param    color Binary (on or off) color to draw with
+*/
+/**************************************************************************/
+void GFXcanvas1::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                           uint16_t color) {
+#if defined(ESP8266)
+  yield();
+#endif
+  if (!buffer)
+    return;
+  int16_t cx0 = 0, cx1 = _width - 1, cy0 = 0, cy1 = _height - 1;
+  clipColumns(cx0, cx1);
+  clipRows(cy0, cy1);
+  dirtyLine(&_dirty, x0, y0, x1, y1, cx0, cy0, cx1, cy1);
+  GFXlineWalk l;
+  lineWalkBegin(&l, x0, y0, x1, y1, _pixelOrigin, _pixelXStep, _pixelYStep);
+  do {
+    if ((l.x >= cx0) && (l.x <= cx1) && (l.y >= cy0) && (l.y <= cy1))
+      writeBit(l.index, color);
+  } while (lineWalkNext(&l));
+}
+
+/**************************************************************************/
+/*!
+   @brief    Copy the visible part of a 1-bit image into the canvas buffer,
+             rotated by stepping through the buffer
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with monochrome bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    color Binary (on or off) color for set bits
+    @param    bg    Binary (on or off) color for unset bits
+    @param    opaque  If false, unset bits are transparent and bg is ignored
+    @param    flash   If true, bitmap is PROGMEM-resident
+*/
+/**************************************************************************/
+void GFXcanvas1::blitBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+                            int16_t w, int16_t h, uint16_t color, uint16_t bg,
+                            bool opaque, bool flash) {
+  if (!buffer || (w < 1) || (h < 1))
+    return;
+  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
+  int16_t cx = x, cy = y, cw = w, ch = h;
+  if (!clipFillRect(cx, cy, cw, ch))
+    return;
+  dirtyRect(&_dirty, cx, cy, cw, ch);
+  int32_t row = _pixelOrigin + cx * _pixelXStep + cy * _pixelYStep;
+  for (int16_t j = cy - y; ch--; j++, row += _pixelYStep) {
+    const uint8_t *src = &bitmap[j * byteWidth + (cx - x) / 8];
+    uint8_t bits = flash ? pgm_read_byte(src) : *src;
+    uint8_t mask = 0x80 >> ((cx - x) & 7);
+    int32_t i = row;
+    for (int16_t n = cw; n--; i += _pixelXStep) {
+      if (bits & mask)
+        writeBit(i, color);
+      else if (opaque)
+        writeBit(i, bg);
+      if (!(mask >>= 1) && n) { // Next bitmap byte, if any pixels are left
+        src++;
+        bits = flash ? pgm_read_byte(src) : *src;
+        mask = 0x80;
+      }
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief      Draw a PROGMEM-resident 1-bit image at the specified (x,y)
+   position, using the specified foreground color (unset bits are transparent).
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with monochrome bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    color Binary (on or off) color to draw with
+*/
+/**************************************************************************/
+void GFXcanvas1::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                            int16_t w, int16_t h, uint16_t color) {
+  blitBitmap(x, y, bitmap, w, h, color, 0, false, true);
+}
+
+/**************************************************************************/
+/*!
+   @brief      Draw a PROGMEM-resident 1-bit image at the specified (x,y)
+   position, using the specified foreground (for set bits) and background (unset
+   bits) colors.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with monochrome bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    color Binary (on or off) color to draw pixels with
+    @param    bg Binary (on or off) color to draw background with
+*/
+/**************************************************************************/
+void GFXcanvas1::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                            int16_t w, int16_t h, uint16_t color,
+                            uint16_t bg) {
+  blitBitmap(x, y, bitmap, w, h, color, bg, true, true);
+}
+
+/**************************************************************************/
+/*!
+   @brief      Draw a RAM-resident 1-bit image at the specified (x,y) position,
+   using the specified foreground color (unset bits are transparent).
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with monochrome bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    color Binary (on or off) color to draw with
+*/
+/**************************************************************************/
+void GFXcanvas1::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                            int16_t h, uint16_t color) {
+  blitBitmap(x, y, bitmap, w, h, color, 0, false, false);
+}
+
+/**************************************************************************/
+/*!
+   @brief      Draw a RAM-resident 1-bit image at the specified (x,y) position,
+   using the specified foreground (for set bits) and background (unset bits)
+   colors.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with monochrome bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    color Binary (on or off) color to draw pixels with
+    @param    bg Binary (on or off) color to draw background with
+*/
+/**************************************************************************/
+void GFXcanvas1::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                            int16_t h, uint16_t color, uint16_t bg) {
+  blitBitmap(x, y, bitmap, w, h, color, bg, true, false);
+}
+
+/**************************************************************************/
+/*!
+   @brief   Copy an already-clipped area of another 1-bit canvas directly
+   into the canvas buffer, stepping through both buffers at their rotations
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    src Canvas to copy from
+    @param    sx  Top left corner x coordinate of area within src
+    @param    sy  Top left corner y coordinate of area within src
+    @param    w   Width of area in pixels
+    @param    h   Height of area in pixels
+    @param    color  Binary (on or off) color for set pixels
+    @param    bg     Binary (on or off) color for unset pixels
+    @param    opaque If false, unset pixels are transparent and bg is ignored
+*/
+/**************************************************************************/
+void GFXcanvas1::blitCanvas(int16_t x, int16_t y, const GFXcanvas1 &src,
+                            int16_t sx, int16_t sy, int16_t w, int16_t h,
+                            uint16_t color, uint16_t bg, bool opaque) {
+  if (!buffer || !src.buffer)
+    return;
+  dirtyRect(&_dirty, x, y, w, h);
+  int32_t row = _pixelOrigin + x * _pixelXStep + y * _pixelYStep;
+  int32_t srow = src._pixelOrigin + sx * src._pixelXStep + sy * src._pixelYStep;
+  for (; h--; row += _pixelYStep, srow += src._pixelYStep) {
+    int32_t i = row, s = srow;
+    for (int16_t n = w; n--; i += _pixelXStep, s += src._pixelXStep) {
+      if (src.readBit(s))
+        writeBit(i, color);
+      else if (opaque)
+        writeBit(i, bg);
+    }
+  }
+}
+
 /**************************************************************************/
 /*!
    @brief  Speed optimized vertical line drawing
@@ -2169,6 +4171,9 @@ void GFXcanvas1::fillScreen(uint16_t color) {
 /**************************************************************************/
 void GFXcanvas1::drawFastVLine(int16_t x, int16_t y, int16_t h,
                                uint16_t color) {
+  int16_t w = 1;
+  if (_clipActive && !clipRect(x, y, w, h))
+    return; // Nothing within the clip rectangle
 
   if (h < 0) { // Convert negative heights to positive equivalent
     h *= -1;
@@ -2192,6 +4197,7 @@ void GFXcanvas1::drawFastVLine(int16_t x, int16_t y, int16_t h,
     h = height() - y;
   }
 
+  dirtyRect(&_dirty, x, y, 1, h);
   if (getRotation() == 0) {
     drawFastRawVLine(x, y, h, color);
   } else if (getRotation() == 1) {
@@ -2225,6 +4231,10 @@ void GFXcanvas1::drawFastVLine(int16_t x, int16_t y, int16_t h,
 /**************************************************************************/
 void GFXcanvas1::drawFastHLine(int16_t x, int16_t y, int16_t w,
                                uint16_t color) {
+  int16_t h = 1;
+  if (_clipActive && !clipRect(x, y, w, h))
+    return; // Nothing within the clip rectangle
+
   if (w < 0) { // Convert negative widths to positive equivalent
     w *= -1;
     x -= w - 1;
@@ -2247,6 +4257,7 @@ void GFXcanvas1::drawFastHLine(int16_t x, int16_t y, int16_t w,
     w = width() - x;
   }
 
+  dirtyRect(&_dirty, x, y, w, 1);
   if (getRotation() == 0) {
     drawFastRawHLine(x, y, w, color);
   } else if (getRotation() == 1) {
@@ -2321,52 +4332,38 @@ void GFXcanvas1::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
   // x & y already in raw (rotation 0) coordinates, no need to transform.
   int16_t rowBytes = ((WIDTH + 7) / 8);
   uint8_t *ptr = &buffer[(x / 8) + y * rowBytes];
-  size_t remainingWidthBits = w;
+  uint8_t x0 = x & 7;  // First bit in first byte
+  int16_t x1 = x0 + w; // End bit (exclusive), counting from first byte
 
-  // check to see if first byte needs to be partially filled
-  if ((x & 7) > 0) {
-    // create bit mask for first byte
-    uint8_t startByteBitMask = 0x00;
-    for (int8_t i = (x & 7); ((i < 8) && (remainingWidthBits > 0)); i++) {
+  // Masks of the bits in the first and last byte: bits from x0 on, and
+  // bits before x1 (both from 0xFF>>n, no per-bit loops). endMask is 0
+  // if the last byte is whole or there is no partial last byte.
 #ifdef __AVR__
-      startByteBitMask |= pgm_read_byte(&GFXsetBit[i]);
+  uint8_t startMask = pgm_read_byte(&GFXrunMask[x0]);
+  uint8_t endMask = ~pgm_read_byte(&GFXrunMask[(x1 > 8) ? x1 & 7 : x1]);
 #else
-      startByteBitMask |= (0x80 >> i);
+  uint8_t startMask = 0xFF >> x0;
+  uint8_t endMask = ~(0xFF >> ((x1 > 8) ? x1 & 7 : x1));
 #endif
-      remainingWidthBits--;
-    }
-    if (color > 0) {
-      *ptr |= startByteBitMask;
-    } else {
-      *ptr &= ~startByteBitMask;
-    }
-
-    ptr++;
-  }
-
-  // do the next remainingWidthBits bits
-  if (remainingWidthBits > 0) {
-    size_t remainingWholeBytes = remainingWidthBits / 8;
-    size_t lastByteBits = remainingWidthBits % 8;
-    uint8_t wholeByteColor = color > 0 ? 0xFF : 0x00;
-
-    memset(ptr, wholeByteColor, remainingWholeBytes);
 
-    if (lastByteBits > 0) {
-      uint8_t lastByteBitMask = 0x00;
-      for (size_t i = 0; i < lastByteBits; i++) {
-#ifdef __AVR__
-        lastByteBitMask |= pgm_read_byte(&GFXsetBit[i]);
-#else
-        lastByteBitMask |= (0x80 >> i);
-#endif
-      }
-      ptr += remainingWholeBytes;
+  if (x1 <= 8) // Starts and ends within one byte
+    startMask &= endMask;
 
+  if (color > 0) {
+    *ptr++ |= startMask;
+  } else {
+    *ptr++ &= ~startMask;
+  }
+  if (x1 > 8) {
+    // Whole bytes in between; memset() fills these a word at a time
+    size_t wholeBytes = (x1 >> 3) - 1;
+    memset(ptr, color > 0 ? 0xFF : 0x00, wholeBytes);
+    ptr += wholeBytes;
+    if (endMask) { // Partial last byte
       if (color > 0) {
-        *ptr |= lastByteBitMask;
+        *ptr |= endMask;
       } else {
-        *ptr &= ~lastByteBitMask;
+        *ptr &= ~endMask;
       }
     }
   }
@@ -2384,7 +4381,9 @@ void GFXcanvas1::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
 */
 /**************************************************************************/
 GFXcanvas8::GFXcanvas8(uint16_t w, uint16_t h, bool allocate_buffer)
-    : Adafruit_GFX(w, h), buffer_owned(allocate_buffer) {
+    : Adafruit_GFX(w, h), buffer_owned(allocate_buffer), _palette(NULL) {
+  dirtyClear(&_dirty);
+  canvasSteps(0, w, h, w, &_pixelOrigin, &_pixelXStep, &_pixelYStep);
   if (allocate_buffer) {
     uint32_t bytes = w * h;
     if ((buffer = (uint8_t *)malloc(bytes))) {
@@ -2414,28 +4413,13 @@ GFXcanvas8::~GFXcanvas8(void) {
 /**************************************************************************/
 void GFXcanvas8::drawPixel(int16_t x, int16_t y, uint16_t color) {
   if (buffer) {
-    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height) ||
+        !inClip(x, y))
       return;
 
-    int16_t t;
-    switch (rotation) {
-    case 1:
-      t = x;
-      x = WIDTH - 1 - y;
-      y = t;
-      break;
-    case 2:
-      x = WIDTH - 1 - x;
-      y = HEIGHT - 1 - y;
-      break;
-    case 3:
-      t = x;
-      x = y;
-      y = HEIGHT - 1 - t;
-      break;
-    }
-
-    buffer[x + y * WIDTH] = color;
+    dirtyPoint(&_dirty, x, y);
+    // Rotated by the steps set in setRotation()
+    buffer[_pixelOrigin + x * _pixelXStep + y * _pixelYStep] = color;
   }
 }
 
@@ -2446,28 +4430,39 @@ void GFXcanvas8::drawPixel(int16_t x, int16_t y, uint16_t color) {
         @param    y   y coordinate
         @returns  The desired pixel's 8-bit color value
 */
-/**********************************************************************/
-uint8_t GFXcanvas8::getPixel(int16_t x, int16_t y) const {
-  int16_t t;
-  switch (rotation) {
-  case 1:
-    t = x;
-    x = WIDTH - 1 - y;
-    y = t;
-    break;
-  case 2:
-    x = WIDTH - 1 - x;
-    y = HEIGHT - 1 - y;
-    break;
-  case 3:
-    t = x;
-    x = y;
-    y = HEIGHT - 1 - t;
-    break;
-  }
-  return getRawPixel(x, y);
+/**********************************************************************/
+uint8_t GFXcanvas8::getPixel(int16_t x, int16_t y) const {
+  if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height) || !buffer)
+    return 0;
+  return buffer[_pixelOrigin + x * _pixelXStep + y * _pixelYStep];
+}
+
+/**************************************************************************/
+/*!
+    @brief  Get the area changed by drawing since the last
+            clearDirtyRect() (or since the canvas was made), so only that
+            part of the buffer needs sending to a display. Any of the
+            pointers may be NULL.
+    @param  x  Left edge of area, in current rotation's coordinates
+    @param  y  Top edge of area
+    @param  w  Width of area, 0 if nothing has changed
+    @param  h  Height of area, 0 if nothing has changed
+    @returns  true if anything has changed
+*/
+/**************************************************************************/
+bool GFXcanvas8::getDirtyRect(int16_t *x, int16_t *y, int16_t *w,
+                              int16_t *h) const {
+  return dirtyGet(&_dirty, x, y, w, h);
 }
 
+/**************************************************************************/
+/*!
+    @brief  Mark the whole canvas unchanged, e.g. after sending the dirty
+            area to a display
+*/
+/**************************************************************************/
+void GFXcanvas8::clearDirtyRect(void) { dirtyClear(&_dirty); }
+
 /**********************************************************************/
 /*!
         @brief    Get the pixel color value at a given, unrotated coordinate.
@@ -2494,11 +4489,226 @@ uint8_t GFXcanvas8::getRawPixel(int16_t x, int16_t y) const {
 */
 /**************************************************************************/
 void GFXcanvas8::fillScreen(uint16_t color) {
-  if (buffer) {
+  if (_clipActive) {
+    fillRect(0, 0, _width, _height, color); // Only within clip rectangle
+  } else if (buffer) {
+    dirtyRect(&_dirty, 0, 0, _width, _height);
     memset(buffer, color, WIDTH * HEIGHT);
   }
 }
 
+/**************************************************************************/
+/*!
+   @brief    Fill a rectangle directly in the canvas buffer, a row at a time
+   @param    x   Top left corner x coordinate
+   @param    y   Top left corner y coordinate
+   @param    w   Width in pixels
+   @param    h   Height in pixels
+   @param    color   8-bit Color to fill with. Only lower byte of uint16_t is
+   used.
+*/
+/**************************************************************************/
+void GFXcanvas8::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                          uint16_t color) {
+  // Negative widths draw nothing, as with Adafruit_GFX::fillRect()
+  if (!buffer || (w < 1) || !clipFillRect(x, y, w, h))
+    return;
+  dirtyRect(&_dirty, x, y, w, h);
+  rotateRect(x, y, w, h); // Once for the whole rect, not per pixel
+  uint8_t *ptr = buffer + (int32_t)y * WIDTH + x;
+  if (w == WIDTH) { // Full rows are contiguous, fill all at once
+    memset(ptr, color, (uint32_t)w * h);
+  } else {
+    for (; h--; ptr += WIDTH)
+      memset(ptr, color, w);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set rotation setting for display, and the buffer steps used to
+            draw into the canvas at that rotation
+    @param  r  0 thru 3 corresponding to 4 cardinal rotations
+*/
+/**************************************************************************/
+void GFXcanvas8::setRotation(uint8_t r) {
+  dirtyRotate(&_dirty, rotation, r & 3, WIDTH, HEIGHT);
+  Adafruit_GFX::setRotation(r);
+  canvasSteps(rotation, WIDTH, HEIGHT, WIDTH, &_pixelOrigin, &_pixelXStep,
+              &_pixelYStep);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw a line directly into the canvas buffer, stepping the buffer
+             index along with the line instead of rotating every pixel
+    @param    x0  Start point x coordinate
+    @param    y0  Start point y coordinate
+    @param    x1  End point x coordinate
+    @param    y1  End point y coordinate
+    @param    color 8-bit Color to draw with
+*/
+/**************************************************************************/
+void GFXcanvas8::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                           uint16_t color) {
+#if defined(ESP8266)
+  yield();
+#endif
+  if (!buffer)
+    return;
+  int16_t cx0 = 0, cx1 = _width - 1, cy0 = 0, cy1 = _height - 1;
+  clipColumns(cx0, cx1);
+  clipRows(cy0, cy1);
+  dirtyLine(&_dirty, x0, y0, x1, y1, cx0, cy0, cx1, cy1);
+  GFXlineWalk l;
+  lineWalkBegin(&l, x0, y0, x1, y1, _pixelOrigin, _pixelXStep, _pixelYStep);
+  do {
+    if ((l.x >= cx0) && (l.x <= cx1) && (l.y >= cy0) && (l.y <= cy1))
+      buffer[l.index] = color;
+  } while (lineWalkNext(&l));
+}
+
+/**************************************************************************/
+/*!
+   @brief    Copy the visible part of an 8-bit image into the canvas buffer,
+             rotated by stepping through the buffer
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with grayscale bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    flash   If true, bitmap is PROGMEM-resident
+*/
+/**************************************************************************/
+void GFXcanvas8::blitGrayscale(int16_t x, int16_t y, const uint8_t *bitmap,
+                               int16_t w, int16_t h, bool flash) {
+  if (!buffer || (w < 1) || (h < 1))
+    return;
+  int16_t cx = x, cy = y, cw = w, ch = h;
+  if (!clipFillRect(cx, cy, cw, ch))
+    return;
+  dirtyRect(&_dirty, cx, cy, cw, ch);
+  int32_t row = _pixelOrigin + cx * _pixelXStep + cy * _pixelYStep;
+  for (int16_t j = cy - y; ch--; j++, row += _pixelYStep) {
+    const uint8_t *src = &bitmap[(int32_t)j * w + (cx - x)];
+    if (!flash && (_pixelXStep == 1)) { // Unrotated rows are contiguous
+      memcpy(&buffer[row], src, cw);
+      continue;
+    }
+    int32_t i = row;
+    for (int16_t n = cw; n--; i += _pixelXStep, src++)
+      buffer[i] = flash ? pgm_read_byte(src) : *src;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a PROGMEM-resident 8-bit image (grayscale) at the specified
+   (x,y) pos, directly into the canvas buffer.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with grayscale bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+*/
+/**************************************************************************/
+void GFXcanvas8::drawGrayscaleBitmap(int16_t x, int16_t y,
+                                     const uint8_t bitmap[], int16_t w,
+                                     int16_t h) {
+  blitGrayscale(x, y, bitmap, w, h, true);
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a RAM-resident 8-bit image (grayscale) at the specified (x,y)
+   pos, directly into the canvas buffer.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with grayscale bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+*/
+/**************************************************************************/
+void GFXcanvas8::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                                     int16_t w, int16_t h) {
+  blitGrayscale(x, y, bitmap, w, h, false);
+}
+
+/**************************************************************************/
+/*!
+   @brief   Copy an already-clipped area of a 1-bit canvas directly into the
+   canvas buffer, stepping through both buffers at their rotations
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    src Canvas to copy from
+    @param    sx  Top left corner x coordinate of area within src
+    @param    sy  Top left corner y coordinate of area within src
+    @param    w   Width of area in pixels
+    @param    h   Height of area in pixels
+    @param    color  8-bit color for set pixels
+    @param    bg     8-bit color for unset pixels
+    @param    opaque If false, unset pixels are transparent and bg is ignored
+*/
+/**************************************************************************/
+void GFXcanvas8::blitCanvas(int16_t x, int16_t y, const GFXcanvas1 &src,
+                            int16_t sx, int16_t sy, int16_t w, int16_t h,
+                            uint16_t color, uint16_t bg, bool opaque) {
+  if (!buffer || !src.buffer)
+    return;
+  dirtyRect(&_dirty, x, y, w, h);
+  int32_t row = _pixelOrigin + x * _pixelXStep + y * _pixelYStep;
+  int32_t srow = src._pixelOrigin + sx * src._pixelXStep + sy * src._pixelYStep;
+  for (; h--; row += _pixelYStep, srow += src._pixelYStep) {
+    int32_t i = row, s = srow;
+    for (int16_t n = w; n--; i += _pixelXStep, s += src._pixelXStep) {
+      if (src.readBit(s))
+        buffer[i] = color;
+      else if (opaque)
+        buffer[i] = bg;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Copy an already-clipped area of another 8-bit canvas directly
+   into the canvas buffer, a row at a time where both are unrotated
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    src Canvas to copy from
+    @param    sx  Top left corner x coordinate of area within src
+    @param    sy  Top left corner y coordinate of area within src
+    @param    w   Width of area in pixels
+    @param    h   Height of area in pixels
+    @param    palette 256 colors to store for each value, or NULL
+    @param    key    Source value that is not drawn, if keyed
+    @param    keyed  If true, pixels of the key value are transparent
+*/
+/**************************************************************************/
+void GFXcanvas8::blitCanvas(int16_t x, int16_t y, const GFXcanvas8 &src,
+                            int16_t sx, int16_t sy, int16_t w, int16_t h,
+                            const uint16_t *palette, uint8_t key, bool keyed) {
+  if (!buffer || !src.buffer)
+    return;
+  dirtyRect(&_dirty, x, y, w, h);
+  bool rows = !palette && !keyed && (_pixelXStep == 1) &&
+              (src._pixelXStep == 1); // Plain copy of contiguous rows
+  int32_t row = _pixelOrigin + x * _pixelXStep + y * _pixelYStep;
+  int32_t srow = src._pixelOrigin + sx * src._pixelXStep + sy * src._pixelYStep;
+  for (; h--; row += _pixelYStep, srow += src._pixelYStep) {
+    if (rows) {
+      memcpy(&buffer[row], &src.buffer[srow], w);
+      continue;
+    }
+    int32_t i = row, s = srow;
+    for (int16_t n = w; n--; i += _pixelXStep, s += src._pixelXStep) {
+      uint8_t v = src.buffer[s];
+      if (!keyed || (v != key))
+        buffer[i] = palette ? palette[v] : v;
+    }
+  }
+}
+
 /**************************************************************************/
 /*!
    @brief  Speed optimized vertical line drawing
@@ -2511,6 +4721,10 @@ void GFXcanvas8::fillScreen(uint16_t color) {
 /**************************************************************************/
 void GFXcanvas8::drawFastVLine(int16_t x, int16_t y, int16_t h,
                                uint16_t color) {
+  int16_t w = 1;
+  if (_clipActive && !clipRect(x, y, w, h))
+    return; // Nothing within the clip rectangle
+
   if (h < 0) { // Convert negative heights to positive equivalent
     h *= -1;
     y -= h - 1;
@@ -2533,6 +4747,7 @@ void GFXcanvas8::drawFastVLine(int16_t x, int16_t y, int16_t h,
     h = height() - y;
   }
 
+  dirtyRect(&_dirty, x, y, 1, h);
   if (getRotation() == 0) {
     drawFastRawVLine(x, y, h, color);
   } else if (getRotation() == 1) {
@@ -2567,6 +4782,9 @@ void GFXcanvas8::drawFastVLine(int16_t x, int16_t y, int16_t h,
 /**************************************************************************/
 void GFXcanvas8::drawFastHLine(int16_t x, int16_t y, int16_t w,
                                uint16_t color) {
+  int16_t h = 1;
+  if (_clipActive && !clipRect(x, y, w, h))
+    return; // Nothing within the clip rectangle
 
   if (w < 0) { // Convert negative widths to positive equivalent
     w *= -1;
@@ -2590,6 +4808,7 @@ void GFXcanvas8::drawFastHLine(int16_t x, int16_t y, int16_t w,
     w = width() - x;
   }
 
+  dirtyRect(&_dirty, x, y, w, 1);
   if (getRotation() == 0) {
     drawFastRawHLine(x, y, w, color);
   } else if (getRotation() == 1) {
@@ -2648,6 +4867,28 @@ void GFXcanvas8::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
   memset(buffer + y * WIDTH + x, color, w);
 }
 
+// 32-bit word that may alias the 16-bit pixels it's written over
+typedef uint32_t __attribute__((__may_alias__)) GFXpixelPair;
+
+// Fill n 16-bit pixels with one color. Most of the run is written as
+// aligned 32-bit words (two pixels per store, four stores per loop), which
+// is the widest single store on Cortex-M and which compilers for larger
+// CPUs widen further to vector stores.
+static void fill16(uint16_t *p, uint16_t color, uint32_t n) {
+  if (n && ((uintptr_t)p & 2)) { // Head pixel, to reach 32-bit alignment
+    *p++ = color;
+    n--;
+  }
+  GFXpixelPair *p2 = (GFXpixelPair *)p, c2 = ((uint32_t)color << 16) | color;
+  uint32_t pairs = n >> 1;
+  for (; pairs >= 4; pairs -= 4, p2 += 4)
+    p2[0] = p2[1] = p2[2] = p2[3] = c2;
+  while (pairs--)
+    *p2++ = c2;
+  if (n & 1) // Tail pixel
+    *(uint16_t *)p2 = color;
+}
+
 /**************************************************************************/
 /*!
    @brief    Instatiate a GFX 16-bit canvas context for graphics
@@ -2657,10 +4898,18 @@ void GFXcanvas8::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
    false, the subclass must initialize the buffer before any drawing operation,
    and free it in the destructor. If false (the default), the buffer is
    allocated and freed by the library.
+   @param    big_endian If true, pixels are stored in the buffer most
+   significant byte first, the order most displays expect, so the buffer can
+   be sent (e.g. by DMA) without a byteSwap() pass. Drawing and getPixel()
+   still use normal 16-bit colors.
 */
 /**************************************************************************/
-GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h, bool allocate_buffer)
-    : Adafruit_GFX(w, h), buffer_owned(allocate_buffer) {
+GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h, bool allocate_buffer,
+                         bool big_endian)
+    : Adafruit_GFX(w, h), buffer_owned(allocate_buffer),
+      _bigEndian(big_endian) {
+  dirtyClear(&_dirty);
+  canvasSteps(0, w, h, w, &_pixelOrigin, &_pixelXStep, &_pixelYStep);
   if (allocate_buffer) {
     uint32_t bytes = w * h * 2;
     if ((buffer = (uint16_t *)malloc(bytes))) {
@@ -2691,28 +4940,14 @@ GFXcanvas16::~GFXcanvas16(void) {
 /**************************************************************************/
 void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
   if (buffer) {
-    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height) ||
+        !inClip(x, y))
       return;
 
-    int16_t t;
-    switch (rotation) {
-    case 1:
-      t = x;
-      x = WIDTH - 1 - y;
-      y = t;
-      break;
-    case 2:
-      x = WIDTH - 1 - x;
-      y = HEIGHT - 1 - y;
-      break;
-    case 3:
-      t = x;
-      x = y;
-      y = HEIGHT - 1 - t;
-      break;
-    }
-
-    buffer[x + y * WIDTH] = color;
+    dirtyPoint(&_dirty, x, y);
+    // Rotated by the steps set in setRotation()
+    buffer[_pixelOrigin + x * _pixelXStep + y * _pixelYStep] =
+        bufferOrder(color);
   }
 }
 
@@ -2725,26 +4960,37 @@ void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
 */
 /**********************************************************************/
 uint16_t GFXcanvas16::getPixel(int16_t x, int16_t y) const {
-  int16_t t;
-  switch (rotation) {
-  case 1:
-    t = x;
-    x = WIDTH - 1 - y;
-    y = t;
-    break;
-  case 2:
-    x = WIDTH - 1 - x;
-    y = HEIGHT - 1 - y;
-    break;
-  case 3:
-    t = x;
-    x = y;
-    y = HEIGHT - 1 - t;
-    break;
-  }
-  return getRawPixel(x, y);
+  if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height) || !buffer)
+    return 0;
+  return bufferOrder(buffer[_pixelOrigin + x * _pixelXStep + y * _pixelYStep]);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Get the area changed by drawing since the last
+            clearDirtyRect() (or since the canvas was made), so only that
+            part of the buffer needs sending to a display. Any of the
+            pointers may be NULL.
+    @param  x  Left edge of area, in current rotation's coordinates
+    @param  y  Top edge of area
+    @param  w  Width of area, 0 if nothing has changed
+    @param  h  Height of area, 0 if nothing has changed
+    @returns  true if anything has changed
+*/
+/**************************************************************************/
+bool GFXcanvas16::getDirtyRect(int16_t *x, int16_t *y, int16_t *w,
+                               int16_t *h) const {
+  return dirtyGet(&_dirty, x, y, w, h);
 }
 
+/**************************************************************************/
+/*!
+    @brief  Mark the whole canvas unchanged, e.g. after sending the dirty
+            area to a display
+*/
+/**************************************************************************/
+void GFXcanvas16::clearDirtyRect(void) { dirtyClear(&_dirty); }
+
 /**********************************************************************/
 /*!
         @brief    Get the pixel color value at a given, unrotated coordinate.
@@ -2759,7 +5005,7 @@ uint16_t GFXcanvas16::getRawPixel(int16_t x, int16_t y) const {
   if ((x < 0) || (y < 0) || (x >= WIDTH) || (y >= HEIGHT))
     return 0;
   if (buffer) {
-    return buffer[x + y * WIDTH];
+    return bufferOrder(buffer[x + y * WIDTH]);
   }
   return 0;
 }
@@ -2771,14 +5017,262 @@ uint16_t GFXcanvas16::getRawPixel(int16_t x, int16_t y) const {
 */
 /**************************************************************************/
 void GFXcanvas16::fillScreen(uint16_t color) {
-  if (buffer) {
+  if (_clipActive) {
+    fillRect(0, 0, _width, _height, color); // Only within clip rectangle
+  } else if (buffer) {
+    dirtyRect(&_dirty, 0, 0, _width, _height);
     uint8_t hi = color >> 8, lo = color & 0xFF;
     if (hi == lo) {
       memset(buffer, lo, WIDTH * HEIGHT * 2);
     } else {
-      uint32_t i, pixels = WIDTH * HEIGHT;
-      for (i = 0; i < pixels; i++)
+      fill16(buffer, bufferOrder(color), (uint32_t)WIDTH * HEIGHT);
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Fill a rectangle directly in the canvas buffer, a row at a time
+   @param    x   Top left corner x coordinate
+   @param    y   Top left corner y coordinate
+   @param    w   Width in pixels
+   @param    h   Height in pixels
+   @param    color   16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                           uint16_t color) {
+  // Negative widths draw nothing, as with Adafruit_GFX::fillRect()
+  if (!buffer || (w < 1) || !clipFillRect(x, y, w, h))
+    return;
+  dirtyRect(&_dirty, x, y, w, h);
+  rotateRect(x, y, w, h); // Once for the whole rect, not per pixel
+  color = bufferOrder(color);
+  uint16_t *ptr = buffer + (int32_t)y * WIDTH + x;
+  if (w == WIDTH) { // Full rows are contiguous, fill all at once
+    fill16(ptr, color, (uint32_t)w * h);
+  } else {
+    for (; h--; ptr += WIDTH)
+      fill16(ptr, color, w);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set rotation setting for display, and the buffer steps used to
+            draw into the canvas at that rotation
+    @param  r  0 thru 3 corresponding to 4 cardinal rotations
+*/
+/**************************************************************************/
+void GFXcanvas16::setRotation(uint8_t r) {
+  dirtyRotate(&_dirty, rotation, r & 3, WIDTH, HEIGHT);
+  Adafruit_GFX::setRotation(r);
+  canvasSteps(rotation, WIDTH, HEIGHT, WIDTH, &_pixelOrigin, &_pixelXStep,
+              &_pixelYStep);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw a line directly into the canvas buffer, stepping the buffer
+             index along with the line instead of rotating every pixel
+    @param    x0  Start point x coordinate
+    @param    y0  Start point y coordinate
+    @param    x1  End point x coordinate
+    @param    y1  End point y coordinate
+    @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void GFXcanvas16::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                            uint16_t color) {
+#if defined(ESP8266)
+  yield();
+#endif
+  if (!buffer)
+    return;
+  int16_t cx0 = 0, cx1 = _width - 1, cy0 = 0, cy1 = _height - 1;
+  clipColumns(cx0, cx1);
+  clipRows(cy0, cy1);
+  dirtyLine(&_dirty, x0, y0, x1, y1, cx0, cy0, cx1, cy1);
+  color = bufferOrder(color);
+  GFXlineWalk l;
+  lineWalkBegin(&l, x0, y0, x1, y1, _pixelOrigin, _pixelXStep, _pixelYStep);
+  do {
+    if ((l.x >= cx0) && (l.x <= cx1) && (l.y >= cy0) && (l.y <= cy1))
+      buffer[l.index] = color;
+  } while (lineWalkNext(&l));
+}
+
+/**************************************************************************/
+/*!
+   @brief    Copy the visible part of a 16-bit image into the canvas buffer,
+             rotated by stepping through the buffer
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  16-bit array with 5-6-5 color bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    flash   If true, bitmap is PROGMEM-resident
+*/
+/**************************************************************************/
+void GFXcanvas16::blitRGB(int16_t x, int16_t y, const uint16_t *bitmap,
+                          int16_t w, int16_t h, bool flash) {
+  if (!buffer || (w < 1) || (h < 1))
+    return;
+  int16_t cx = x, cy = y, cw = w, ch = h;
+  if (!clipFillRect(cx, cy, cw, ch))
+    return;
+  dirtyRect(&_dirty, cx, cy, cw, ch);
+  int32_t row = _pixelOrigin + cx * _pixelXStep + cy * _pixelYStep;
+  for (int16_t j = cy - y; ch--; j++, row += _pixelYStep) {
+    const uint16_t *src = &bitmap[(int32_t)j * w + (cx - x)];
+    if (!flash && !_bigEndian && (_pixelXStep == 1)) { // Contiguous rows
+      memcpy(&buffer[row], src, cw * 2);
+      continue;
+    }
+    int32_t i = row;
+    for (int16_t n = cw; n--; i += _pixelXStep, src++)
+      buffer[i] = bufferOrder(flash ? pgm_read_word(src) : *src);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a PROGMEM-resident 16-bit image (RGB 5/6/5) at the specified
+   (x,y) position, directly into the canvas buffer.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with 16-bit color bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+*/
+/**************************************************************************/
+void GFXcanvas16::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
+                                int16_t w, int16_t h) {
+  blitRGB(x, y, bitmap, w, h, true);
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a RAM-resident 16-bit image (RGB 5/6/5) at the specified (x,y)
+   position, directly into the canvas buffer.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with 16-bit color bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+*/
+/**************************************************************************/
+void GFXcanvas16::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
+                                int16_t w, int16_t h) {
+  blitRGB(x, y, bitmap, w, h, false);
+}
+
+/**************************************************************************/
+/*!
+   @brief   Copy an already-clipped area of a 1-bit canvas directly into the
+   canvas buffer, stepping through both buffers at their rotations
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    src Canvas to copy from
+    @param    sx  Top left corner x coordinate of area within src
+    @param    sy  Top left corner y coordinate of area within src
+    @param    w   Width of area in pixels
+    @param    h   Height of area in pixels
+    @param    color  16-bit 5-6-5 Color for set pixels
+    @param    bg     16-bit 5-6-5 Color for unset pixels
+    @param    opaque If false, unset pixels are transparent and bg is ignored
+*/
+/**************************************************************************/
+void GFXcanvas16::blitCanvas(int16_t x, int16_t y, const GFXcanvas1 &src,
+                             int16_t sx, int16_t sy, int16_t w, int16_t h,
+                             uint16_t color, uint16_t bg, bool opaque) {
+  if (!buffer || !src.buffer)
+    return;
+  dirtyRect(&_dirty, x, y, w, h);
+  color = bufferOrder(color);
+  bg = bufferOrder(bg);
+  int32_t row = _pixelOrigin + x * _pixelXStep + y * _pixelYStep;
+  int32_t srow = src._pixelOrigin + sx * src._pixelXStep + sy * src._pixelYStep;
+  for (; h--; row += _pixelYStep, srow += src._pixelYStep) {
+    int32_t i = row, s = srow;
+    for (int16_t n = w; n--; i += _pixelXStep, s += src._pixelXStep) {
+      if (src.readBit(s))
         buffer[i] = color;
+      else if (opaque)
+        buffer[i] = bg;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Copy an already-clipped area of an 8-bit canvas directly into the
+   canvas buffer, expanding values to colors through a palette if given
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    src Canvas to copy from
+    @param    sx  Top left corner x coordinate of area within src
+    @param    sy  Top left corner y coordinate of area within src
+    @param    w   Width of area in pixels
+    @param    h   Height of area in pixels
+    @param    palette 256 16-bit colors to store for each value, or NULL
+    @param    key    Source value that is not drawn, if keyed
+    @param    keyed  If true, pixels of the key value are transparent
+*/
+/**************************************************************************/
+void GFXcanvas16::blitCanvas(int16_t x, int16_t y, const GFXcanvas8 &src,
+                             int16_t sx, int16_t sy, int16_t w, int16_t h,
+                             const uint16_t *palette, uint8_t key, bool keyed) {
+  if (!buffer || !src.buffer)
+    return;
+  dirtyRect(&_dirty, x, y, w, h);
+  int32_t row = _pixelOrigin + x * _pixelXStep + y * _pixelYStep;
+  int32_t srow = src._pixelOrigin + sx * src._pixelXStep + sy * src._pixelYStep;
+  for (; h--; row += _pixelYStep, srow += src._pixelYStep) {
+    int32_t i = row, s = srow;
+    for (int16_t n = w; n--; i += _pixelXStep, s += src._pixelXStep) {
+      uint8_t v = src.buffer[s];
+      if (!keyed || (v != key))
+        buffer[i] = bufferOrder(palette ? palette[v] : v);
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Copy an already-clipped area of another 16-bit canvas directly
+   into the canvas buffer, a row at a time where both are unrotated
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    src Canvas to copy from
+    @param    sx  Top left corner x coordinate of area within src
+    @param    sy  Top left corner y coordinate of area within src
+    @param    w   Width of area in pixels
+    @param    h   Height of area in pixels
+    @param    key    16-bit 5-6-5 Color that is not drawn, if keyed
+    @param    keyed  If true, pixels of the key color are transparent
+*/
+/**************************************************************************/
+void GFXcanvas16::blitCanvas(int16_t x, int16_t y, const GFXcanvas16 &src,
+                             int16_t sx, int16_t sy, int16_t w, int16_t h,
+                             uint16_t key, bool keyed) {
+  if (!buffer || !src.buffer)
+    return;
+  dirtyRect(&_dirty, x, y, w, h);
+  bool rows = !keyed && (_bigEndian == src._bigEndian) &&
+              (_pixelXStep == 1) && (src._pixelXStep == 1); // Plain copy
+  int32_t row = _pixelOrigin + x * _pixelXStep + y * _pixelYStep;
+  int32_t srow = src._pixelOrigin + sx * src._pixelXStep + sy * src._pixelYStep;
+  for (; h--; row += _pixelYStep, srow += src._pixelYStep) {
+    if (rows) {
+      memcpy(&buffer[row], &src.buffer[srow], w * 2);
+      continue;
+    }
+    int32_t i = row, s = srow;
+    for (int16_t n = w; n--; i += _pixelXStep, s += src._pixelXStep) {
+      uint16_t c = src.bufferOrder(src.buffer[s]);
+      if (!keyed || (c != key))
+        buffer[i] = bufferOrder(c);
     }
   }
 }
@@ -2793,7 +5287,9 @@ void GFXcanvas16::fillScreen(uint16_t color) {
             automatically, but some specialized code (usually involving
             DMA) can benefit from having pixel data already in the
             display-native order. Note that this does NOT convert to a
-            SPECIFIC endian-ness, it just flips the bytes within each word.
+            SPECIFIC endian-ness, it just flips the bytes within each word,
+            and doesn't change the order used by drawing functions (see
+            the big_endian constructor argument for that).
 */
 /**************************************************************************/
 void GFXcanvas16::byteSwap(void) {
@@ -2815,6 +5311,10 @@ void GFXcanvas16::byteSwap(void) {
 /**************************************************************************/
 void GFXcanvas16::drawFastVLine(int16_t x, int16_t y, int16_t h,
                                 uint16_t color) {
+  int16_t w = 1;
+  if (_clipActive && !clipRect(x, y, w, h))
+    return; // Nothing within the clip rectangle
+
   if (h < 0) { // Convert negative heights to positive equivalent
     h *= -1;
     y -= h - 1;
@@ -2837,6 +5337,7 @@ void GFXcanvas16::drawFastVLine(int16_t x, int16_t y, int16_t h,
     h = height() - y;
   }
 
+  dirtyRect(&_dirty, x, y, 1, h);
   if (getRotation() == 0) {
     drawFastRawVLine(x, y, h, color);
   } else if (getRotation() == 1) {
@@ -2870,6 +5371,10 @@ void GFXcanvas16::drawFastVLine(int16_t x, int16_t y, int16_t h,
 /**************************************************************************/
 void GFXcanvas16::drawFastHLine(int16_t x, int16_t y, int16_t w,
                                 uint16_t color) {
+  int16_t h = 1;
+  if (_clipActive && !clipRect(x, y, w, h))
+    return; // Nothing within the clip rectangle
+
   if (w < 0) { // Convert negative widths to positive equivalent
     w *= -1;
     x -= w - 1;
@@ -2892,6 +5397,7 @@ void GFXcanvas16::drawFastHLine(int16_t x, int16_t y, int16_t w,
     w = width() - x;
   }
 
+  dirtyRect(&_dirty, x, y, w, 1);
   if (getRotation() == 0) {
     drawFastRawHLine(x, y, w, color);
   } else if (getRotation() == 1) {
@@ -2927,6 +5433,7 @@ void GFXcanvas16::drawFastRawVLine(int16_t x, int16_t y, int16_t h,
                                    uint16_t color) {
   // x & y already in raw (rotation 0) coordinates, no need to transform.
   uint16_t *buffer_ptr = buffer + y * WIDTH + x;
+  color = bufferOrder(color);
   for (int16_t i = 0; i < h; i++) {
     (*buffer_ptr) = color;
     buffer_ptr += WIDTH;
@@ -2945,8 +5452,5 @@ void GFXcanvas16::drawFastRawVLine(int16_t x, int16_t y, int16_t h,
 void GFXcanvas16::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
                                    uint16_t color) {
   // x & y already in raw (rotation 0) coordinates, no need to transform.
-  uint32_t buffer_index = y * WIDTH + x;
-  for (uint32_t i = buffer_index; i < buffer_index + w; i++) {
-    buffer[i] = color;
-  }
+  fill16(buffer + (int32_t)y * WIDTH + x, bufferOrder(color), w);
 }
@@ -12,6 +12,51 @@
 #include <Adafruit_I2CDevice.h>
 #include <Adafruit_SPIDevice.h>
 
+#ifndef GFX_CLIP_STACK_DEPTH
+#ifdef __AVR__
+#define GFX_CLIP_STACK_DEPTH 2 ///< Max pushClip() nesting, RAM is tight
+#else
+#define GFX_CLIP_STACK_DEPTH 4 ///< Max pushClip() nesting
+#endif
+#endif
+
+class GFXcanvas1;
+class GFXcanvas8;
+class GFXcanvas16;
+
+/// Clip rectangle, as inclusive corners in rotated (user) coordinates
+typedef struct {
+  int16_t x0; ///< Left edge
+  int16_t y0; ///< Top edge
+  int16_t x1; ///< Right edge, inclusive (less than x0 if empty)
+  int16_t y1; ///< Bottom edge, inclusive (less than y0 if empty)
+} GFXclip;
+
+/// One pre-decoded custom font glyph in the optional glyph cache
+typedef struct {
+  const GFXfont *font; ///< Font the glyph is from, NULL if entry is unused
+  uint32_t lastUsed;   ///< Cache access count at last use, for LRU eviction
+  uint8_t c;           ///< Glyph index within font (char minus font->first)
+  uint8_t width;       ///< Bitmap dimensions in pixels
+  uint8_t height;      ///< Bitmap dimensions in pixels
+  int8_t xOffset;      ///< X dist from cursor pos to UL corner
+  int8_t yOffset;      ///< Y dist from cursor pos to UL corner
+  uint8_t numRuns;     ///< Number of runs of set pixels, see GFXglyphCache
+} GFXcachedGlyph;
+
+/// Optional LRU cache of custom font glyphs, see setGlyphCache()
+typedef struct {
+  GFXcachedGlyph *glyphs; ///< Array of cache entries
+  uint8_t *runs; ///< maxRuns runs per entry, 3 bytes each: row, column, length
+  uint8_t size;  ///< Number of entries
+  uint8_t maxRuns; ///< Max runs per glyph, bigger glyphs aren't cached
+  uint32_t tick;   ///< Total lookups, used to timestamp entries
+  uint32_t hits;   ///< Lookups that found the glyph already decoded
+  uint32_t misses; ///< Lookups that had to decode the glyph from PROGMEM
+  const GFXfont *noFitFont; ///< Font that noFit applies to
+  uint8_t noFit[32]; ///< Bit per glyph of noFitFont with over maxRuns runs
+} GFXglyphCache;
+
 /// A generic graphics superclass that can handle all sorts of drawing. At a
 /// minimum you can subclass and provide drawPixel(). At a maximum you can do a
 /// ton of overriding to optimize. Used for any/all Adafruit displays!
@@ -19,6 +64,7 @@ class Adafruit_GFX : public Print {
 
 public:
   Adafruit_GFX(int16_t w, int16_t h); // Constructor
+  ~Adafruit_GFX(void);
 
   /**********************************************************************/
   /*!
@@ -81,6 +127,10 @@ public:
                     int16_t y2, uint16_t color);
   void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2,
                     int16_t y2, uint16_t color);
+  void drawPolygon(const int16_t x[], const int16_t y[], uint16_t n,
+                   uint16_t color);
+  void fillPolygon(const int16_t x[], const int16_t y[], uint16_t n,
+                   uint16_t color);
   void drawRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
                      int16_t radius, uint16_t color);
   void fillRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
@@ -90,6 +140,7 @@ public:
   void fillRotatedRect(int16_t cenX, int16_t cenY, int16_t w, int16_t h,
                        int16_t angleDeg, uint16_t color);
   void rotatePoint(int16_t &x0, int16_t &y0, int16_t angleDeg);
+  void rotatePoints(int16_t x[], int16_t y[], uint16_t n, int16_t angleDeg);
   void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
                   int16_t h, uint16_t color);
   void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
@@ -116,19 +167,49 @@ public:
                      const uint8_t mask[], int16_t w, int16_t h);
   void drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, uint8_t *mask,
                      int16_t w, int16_t h);
+  void drawCanvas(int16_t x, int16_t y, const GFXcanvas1 &src, int16_t sx,
+                  int16_t sy, int16_t w, int16_t h, uint16_t color);
+  void drawCanvas(int16_t x, int16_t y, const GFXcanvas1 &src, int16_t sx,
+                  int16_t sy, int16_t w, int16_t h, uint16_t color,
+                  uint16_t bg);
+  void drawCanvas(int16_t x, int16_t y, const GFXcanvas8 &src, int16_t sx,
+                  int16_t sy, int16_t w, int16_t h,
+                  const uint16_t *palette = NULL);
+  void drawCanvas(int16_t x, int16_t y, const GFXcanvas8 &src, int16_t sx,
+                  int16_t sy, int16_t w, int16_t h, const uint16_t *palette,
+                  uint8_t key);
+  void drawCanvas(int16_t x, int16_t y, const GFXcanvas16 &src, int16_t sx,
+                  int16_t sy, int16_t w, int16_t h);
+  void drawCanvas(int16_t x, int16_t y, const GFXcanvas16 &src, int16_t sx,
+                  int16_t sy, int16_t w, int16_t h, uint16_t key);
   void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
                 uint16_t bg, uint8_t size);
   void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
                 uint16_t bg, uint8_t size_x, uint8_t size_y);
+  void writeChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                 uint16_t bg, uint8_t size_x, uint8_t size_y);
+  size_t drawString(const char *str, size_t len, int16_t *x1 = NULL,
+                    int16_t *y1 = NULL, uint16_t *w = NULL, uint16_t *h = NULL);
   void getTextBounds(const char *string, int16_t x, int16_t y, int16_t *x1,
                      int16_t *y1, uint16_t *w, uint16_t *h);
   void getTextBounds(const __FlashStringHelper *s, int16_t x, int16_t y,
                      int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h);
   void getTextBounds(const String &str, int16_t x, int16_t y, int16_t *x1,
                      int16_t *y1, uint16_t *w, uint16_t *h);
+  virtual void drawOpaqueText(int16_t x, int16_t y, const char *str,
+                              uint16_t color, uint16_t bg);
   void setTextSize(uint8_t s);
   void setTextSize(uint8_t sx, uint8_t sy);
   void setFont(const GFXfont *f = NULL);
+  void setFont(const GFXfont2 &f);
+  bool setGlyphCache(uint8_t glyphs, uint8_t maxRuns = 32);
+  uint32_t getGlyphCacheHits(void) const;
+  uint32_t getGlyphCacheMisses(void) const;
+  void setClipRect(int16_t x, int16_t y, int16_t w, int16_t h);
+  void resetClipRect(void);
+  bool pushClip(int16_t x, int16_t y, int16_t w, int16_t h);
+  void popClip(void);
+  void getClipRect(int16_t *x, int16_t *y, int16_t *w, int16_t *h) const;
 
   /**********************************************************************/
   /*!
@@ -140,6 +221,7 @@ public:
   void setCursor(int16_t x, int16_t y) {
     cursor_x = x;
     cursor_y = y;
+    prevChar = 0;
   }
 
   /**********************************************************************/
@@ -239,6 +321,56 @@ public:
   int16_t getCursorY(void) const { return cursor_y; };
 
 protected:
+  /************************************************************************/
+  /*!
+    @brief  Check a point against the clip rectangle. Display bounds are
+            NOT checked here, that's left to the caller.
+    @param  x  X coordinate in pixels
+    @param  y  Y coordinate in pixels
+    @returns  true if the point may be drawn
+  */
+  /************************************************************************/
+  bool inClip(int16_t x, int16_t y) const {
+    return !_clipActive || ((x >= _clip.x0) && (x <= _clip.x1) &&
+                            (y >= _clip.y0) && (y <= _clip.y1));
+  }
+  bool clipRect(int16_t &x, int16_t &y, int16_t &w, int16_t &h) const;
+  void clipColumns(int16_t &x0, int16_t &x1) const;
+  void clipRows(int16_t &y0, int16_t &y1) const;
+  bool clipFillRect(int16_t &x, int16_t &y, int16_t &w, int16_t &h) const;
+  void rotateRect(int16_t &x, int16_t &y, int16_t &w, int16_t &h) const;
+  bool clipCanvas(int16_t &x, int16_t &y, const Adafruit_GFX &src, int16_t &sx,
+                  int16_t &sy, int16_t &w, int16_t &h) const;
+  int16_t overlapStrips(int16_t &x, int16_t &y, const Adafruit_GFX &src,
+                        int16_t &sx, int16_t &sy, int16_t &w, int16_t &h,
+                        int8_t &dx, int8_t &dy) const;
+  virtual void blitCanvas(int16_t x, int16_t y, const GFXcanvas1 &src,
+                          int16_t sx, int16_t sy, int16_t w, int16_t h,
+                          uint16_t color, uint16_t bg, bool opaque);
+  virtual void blitCanvas(int16_t x, int16_t y, const GFXcanvas8 &src,
+                          int16_t sx, int16_t sy, int16_t w, int16_t h,
+                          const uint16_t *palette, uint8_t key, bool keyed);
+  virtual void blitCanvas(int16_t x, int16_t y, const GFXcanvas16 &src,
+                          int16_t sx, int16_t sy, int16_t w, int16_t h,
+                          uint16_t key, bool keyed);
+  bool layoutChar(unsigned char c, int16_t *x, int16_t *y, int16_t *gx,
+                  int16_t *gy, int16_t *bx, int16_t *by, int16_t *bw,
+                  int16_t *bh, uint8_t *prev);
+  size_t layoutText(const char *str, size_t len, bool flash, bool draw,
+                    int16_t *x, int16_t *y, uint8_t *prev, int16_t *minx,
+                    int16_t *miny, int16_t *maxx, int16_t *maxy);
+  void textBounds(int16_t x, int16_t y, int16_t minx, int16_t miny,
+                  int16_t maxx, int16_t maxy, int16_t *x1, int16_t *y1,
+                  uint16_t *w, uint16_t *h);
+  bool opaqueTextBox(int16_t x, int16_t y, const char *str, int16_t *x1,
+                     int16_t *y1, int16_t *x2, int16_t *y2);
+  void opaqueTextRow(int16_t x, int16_t y, const char *str, int16_t row,
+                     int16_t x0, int16_t w, uint8_t *mask);
+  GFXcachedGlyph *cacheGlyph(uint8_t c);
+  void writeGlyphRun(int16_t x, int16_t y, int8_t xo, int8_t yo, int16_t xx,
+                     int16_t len, int16_t yy, uint8_t size_x, uint8_t size_y,
+                     uint16_t color);
+  void writeSpan(int16_t a, int16_t b, int16_t y, uint16_t color);
   void charBounds(unsigned char c, int16_t *x, int16_t *y, int16_t *minx,
                   int16_t *miny, int16_t *maxx, int16_t *maxy);
   int16_t WIDTH;        ///< This is the 'raw' display width - never changes
@@ -255,6 +387,13 @@ protected:
   bool wrap;            ///< If set, 'wrap' text at right edge of display
   bool _cp437;          ///< If set, use correct CP437 charset (default is off)
   GFXfont *gfxFont;     ///< Pointer to special font
+  const GFXfont2 *gfxFont2;  ///< Version 2 data for gfxFont, or NULL
+  uint8_t prevChar;          ///< Last char print()ed, for kerning (0 if none)
+  GFXglyphCache *glyphCache; ///< Optional glyph cache, NULL if not enabled
+  GFXclip _clip;             ///< Clip rectangle, unbounded if not _clipActive
+  GFXclip _clipStack[GFX_CLIP_STACK_DEPTH]; ///< Saved by pushClip()
+  uint8_t _clipDepth;                       ///< Number of saved clips
+  bool _clipActive; ///< If set, drawing is limited to _clip
 };
 
 /// A simple drawn button UI element
@@ -322,9 +461,23 @@ public:
   ~GFXcanvas1(void);
   void drawPixel(int16_t x, int16_t y, uint16_t color);
   void fillScreen(uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void setRotation(uint8_t r);
+  void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                 uint16_t color);
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                  int16_t h, uint16_t color);
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                  int16_t h, uint16_t color, uint16_t bg);
+  void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h,
+                  uint16_t color);
+  void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h,
+                  uint16_t color, uint16_t bg);
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
   bool getPixel(int16_t x, int16_t y) const;
+  bool getDirtyRect(int16_t *x, int16_t *y, int16_t *w, int16_t *h) const;
+  void clearDirtyRect(void);
   /**********************************************************************/
   /*!
     @brief    Get a pointer to the internal buffer memory
@@ -337,15 +490,54 @@ protected:
   bool getRawPixel(int16_t x, int16_t y) const;
   void drawFastRawVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastRawHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void blitBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w,
+                  int16_t h, uint16_t color, uint16_t bg, bool opaque,
+                  bool flash);
+  using Adafruit_GFX::blitCanvas; // Other source formats, pixel by pixel
+  void blitCanvas(int16_t x, int16_t y, const GFXcanvas1 &src, int16_t sx,
+                  int16_t sy, int16_t w, int16_t h, uint16_t color,
+                  uint16_t bg, bool opaque);
   uint8_t *buffer;   ///< Raster data: no longer private, allow subclass access
   bool buffer_owned; ///< If true, destructor will free buffer, else it will do
                      ///< nothing
 
+  int32_t _pixelOrigin; ///< Bit index of pixel (0,0) at current rotation
+  int32_t _pixelXStep;  ///< Bit index change for x+1 at current rotation
+  int32_t _pixelYStep;  ///< Bit index change for y+1 at current rotation
+  GFXclip _dirty;       ///< Area changed since clearDirtyRect()
+
 private:
 #ifdef __AVR__
   // Bitmask tables of 0x80>>X and ~(0x80>>X), because X>>Y is slow on AVR
   static const uint8_t PROGMEM GFXsetBit[], GFXclrBit[];
+  // And of 0xFF>>X, for start and end masks of horizontal lines
+  static const uint8_t PROGMEM GFXrunMask[];
 #endif
+  // Canvases copying from this one read its buffer directly
+  friend class GFXcanvas8;
+  friend class GFXcanvas16;
+  // Get one pixel, by bit index into buffer
+  inline bool readBit(int32_t i) const {
+#ifdef __AVR__
+    return (buffer[i >> 3] & pgm_read_byte(&GFXsetBit[i & 7])) != 0;
+#else
+    return (buffer[i >> 3] & (0x80 >> (i & 7))) != 0;
+#endif
+  }
+  // Set or clear one pixel, by bit index into buffer
+  inline void writeBit(int32_t i, bool on) {
+#ifdef __AVR__
+    if (on)
+      buffer[i >> 3] |= pgm_read_byte(&GFXsetBit[i & 7]);
+    else
+      buffer[i >> 3] &= pgm_read_byte(&GFXclrBit[i & 7]);
+#else
+    if (on)
+      buffer[i >> 3] |= 0x80 >> (i & 7);
+    else
+      buffer[i >> 3] &= ~(0x80 >> (i & 7));
+#endif
+  }
 };
 
 /// A GFX 8-bit canvas context for graphics
@@ -355,9 +547,20 @@ public:
   ~GFXcanvas8(void);
   void drawPixel(int16_t x, int16_t y, uint16_t color);
   void fillScreen(uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void setRotation(uint8_t r);
+  void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                 uint16_t color);
+  using Adafruit_GFX::drawGrayscaleBitmap; // Keep the masked overloads
+  void drawGrayscaleBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                           int16_t w, int16_t h);
+  void drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                           int16_t h);
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
   uint8_t getPixel(int16_t x, int16_t y) const;
+  bool getDirtyRect(int16_t *x, int16_t *y, int16_t *w, int16_t *h) const;
+  void clearDirtyRect(void);
   /**********************************************************************/
   /*!
    @brief    Get a pointer to the internal buffer memory
@@ -365,27 +568,74 @@ public:
   */
   /**********************************************************************/
   uint8_t *getBuffer(void) const { return buffer; }
+  /**********************************************************************/
+  /*!
+   @brief    Attach a palette, used to convert the canvas's 8-bit values
+             to 16-bit colors whenever it's copied with drawCanvas(). The
+             palette is not copied and must stay valid while attached.
+   @param    p  256 16-bit 5-6-5 colors in RAM, or NULL to detach
+  */
+  /**********************************************************************/
+  void setPalette(const uint16_t *p) { _palette = p; }
+  /**********************************************************************/
+  /*!
+   @brief    Get the palette set with setPalette()
+   @returns  A pointer to the palette, or NULL if none is attached
+  */
+  /**********************************************************************/
+  const uint16_t *getPalette(void) const { return _palette; }
 
 protected:
   uint8_t getRawPixel(int16_t x, int16_t y) const;
   void drawFastRawVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastRawHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void blitGrayscale(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w,
+                     int16_t h, bool flash);
+  using Adafruit_GFX::blitCanvas; // Other source formats, pixel by pixel
+  void blitCanvas(int16_t x, int16_t y, const GFXcanvas1 &src, int16_t sx,
+                  int16_t sy, int16_t w, int16_t h, uint16_t color,
+                  uint16_t bg, bool opaque);
+  void blitCanvas(int16_t x, int16_t y, const GFXcanvas8 &src, int16_t sx,
+                  int16_t sy, int16_t w, int16_t h, const uint16_t *palette,
+                  uint8_t key, bool keyed);
   uint8_t *buffer;   ///< Raster data: no longer private, allow subclass access
   bool buffer_owned; ///< If true, destructor will free buffer, else it will do
                      ///< nothing
+
+  int32_t _pixelOrigin; ///< Buffer index of pixel (0,0) at current rotation
+  int32_t _pixelXStep;  ///< Buffer index change for x+1 at current rotation
+  int32_t _pixelYStep;  ///< Buffer index change for y+1 at current rotation
+  GFXclip _dirty;       ///< Area changed since clearDirtyRect()
+
+  const uint16_t *_palette; ///< Colors for drawCanvas(), NULL if none
+
+private:
+  friend class GFXcanvas16; // Copying from this canvas reads buffer directly
 };
 
 ///  A GFX 16-bit canvas context for graphics
 class GFXcanvas16 : public Adafruit_GFX {
 public:
-  GFXcanvas16(uint16_t w, uint16_t h, bool allocate_buffer = true);
+  GFXcanvas16(uint16_t w, uint16_t h, bool allocate_buffer = true,
+              bool big_endian = false);
   ~GFXcanvas16(void);
   void drawPixel(int16_t x, int16_t y, uint16_t color);
   void fillScreen(uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void setRotation(uint8_t r);
+  void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                 uint16_t color);
+  using Adafruit_GFX::drawRGBBitmap; // Keep the masked overloads
+  void drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[], int16_t w,
+                     int16_t h);
+  void drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w,
+                     int16_t h);
   void byteSwap(void);
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
   uint16_t getPixel(int16_t x, int16_t y) const;
+  bool getDirtyRect(int16_t *x, int16_t *y, int16_t *w, int16_t *h) const;
+  void clearDirtyRect(void);
   /**********************************************************************/
   /*!
     @brief    Get a pointer to the internal buffer memory
@@ -393,14 +643,48 @@ public:
   */
   /**********************************************************************/
   uint16_t *getBuffer(void) const { return buffer; }
+  /**********************************************************************/
+  /*!
+    @brief    Check the byte order of pixels in the buffer
+    @returns  true if stored most significant byte first (display order)
+  */
+  /**********************************************************************/
+  bool isBigEndian(void) const { return _bigEndian; }
 
 protected:
   uint16_t getRawPixel(int16_t x, int16_t y) const;
   void drawFastRawVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastRawHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void blitRGB(int16_t x, int16_t y, const uint16_t *bitmap, int16_t w,
+               int16_t h, bool flash);
+  void blitCanvas(int16_t x, int16_t y, const GFXcanvas1 &src, int16_t sx,
+                  int16_t sy, int16_t w, int16_t h, uint16_t color,
+                  uint16_t bg, bool opaque);
+  void blitCanvas(int16_t x, int16_t y, const GFXcanvas8 &src, int16_t sx,
+                  int16_t sy, int16_t w, int16_t h, const uint16_t *palette,
+                  uint8_t key, bool keyed);
+  void blitCanvas(int16_t x, int16_t y, const GFXcanvas16 &src, int16_t sx,
+                  int16_t sy, int16_t w, int16_t h, uint16_t key, bool keyed);
   uint16_t *buffer;  ///< Raster data: no longer private, allow subclass access
   bool buffer_owned; ///< If true, destructor will free buffer, else it will do
                      ///< nothing
+
+  int32_t _pixelOrigin; ///< Buffer index of pixel (0,0) at current rotation
+  int32_t _pixelXStep;  ///< Buffer index change for x+1 at current rotation
+  int32_t _pixelYStep;  ///< Buffer index change for y+1 at current rotation
+  GFXclip _dirty;       ///< Area changed since clearDirtyRect()
+  bool _bigEndian;      ///< If true, buffer holds byte-swapped (display) order
+
+  /**********************************************************************/
+  /*!
+    @brief    Convert a color to or from the order kept in the buffer
+    @param    c  16-bit 5-6-5 color, or value from the buffer
+    @returns  c, byte-swapped if the canvas is big-endian
+  */
+  /**********************************************************************/
+  uint16_t bufferOrder(uint16_t c) const {
+    return _bigEndian ? __builtin_bswap16(c) : c;
+  }
 };
 
 #endif // _ADAFRUIT_GFX_H
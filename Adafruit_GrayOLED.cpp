@@ -152,6 +152,10 @@ Adafruit_GrayOLED::~Adafruit_GrayOLED(void) {
     free(buffer);
     buffer = NULL;
   }
+  if (dirty_tiles) {
+    free(dirty_tiles);
+    dirty_tiles = NULL;
+  }
   if (spi_dev)
     delete spi_dev;
   if (i2c_dev)
@@ -228,6 +232,11 @@ bool Adafruit_GrayOLED::_init(uint8_t addr, bool reset) {
       !(buffer = (uint8_t *)malloc(_bpp * WIDTH * ((HEIGHT + 7) / 8)))) {
     return false;
   }
+  // and one bit per 8x8 pixel tile for dirty tracking
+  uint16_t tile_bytes = (((WIDTH + 7) / 8) * ((HEIGHT + 7) / 8) + 7) / 8;
+  if ((!dirty_tiles) && !(dirty_tiles = (uint8_t *)malloc(tile_bytes))) {
+    return false;
+  }
 
   // Reset OLED if requested and reset pin specified in constructor
   if (reset && (rstPin >= 0)) {
@@ -283,7 +292,8 @@ bool Adafruit_GrayOLED::_init(uint8_t addr, bool reset) {
             commands as needed by one's own application.
 */
 void Adafruit_GrayOLED::drawPixel(int16_t x, int16_t y, uint16_t color) {
-  if ((x >= 0) && (x < width()) && (y >= 0) && (y < height())) {
+  if ((x >= 0) && (x < width()) && (y >= 0) && (y < height()) &&
+      inClip(x, y)) {
     // Pixel is in-bounds. Rotate coordinates if needed.
     switch (getRotation()) {
     case 1:
@@ -305,6 +315,10 @@ void Adafruit_GrayOLED::drawPixel(int16_t x, int16_t y, uint16_t color) {
     window_y1 = min(window_y1, y);
     window_x2 = max(window_x2, x);
     window_y2 = max(window_y2, y);
+    if (dirty_tiles) {
+      uint16_t t = (y / 8) * ((WIDTH + 7) / 8) + x / 8; // 8x8 tile index
+      dirty_tiles[t / 8] |= 1 << (t & 7);
+    }
 
     if (_bpp == 1) {
       switch (color) {
@@ -335,6 +349,109 @@ void Adafruit_GrayOLED::drawPixel(int16_t x, int16_t y, uint16_t color) {
   }
 }
 
+/*!
+    @brief  Draw a horizontal line, marking its dirty tiles once rather
+            than per pixel.
+    @param  x
+            Leftmost column of line.
+    @param  y
+            Row of line.
+    @param  w
+            Width of line, in pixels.
+    @param  color
+            Line color, as for drawPixel().
+    @note   Changes buffer contents only, no immediate effect on display.
+*/
+void Adafruit_GrayOLED::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                      uint16_t color) {
+  if (w > 0)
+    fillRect(x, y, w, 1, color);
+  else // Keep Adafruit_GFX's handling of odd widths
+    Adafruit_GFX::drawFastHLine(x, y, w, color);
+}
+
+/*!
+    @brief  Draw a vertical line, marking its dirty tiles once rather than
+            per pixel.
+    @param  x
+            Column of line.
+    @param  y
+            Topmost row of line.
+    @param  h
+            Height of line, in pixels.
+    @param  color
+            Line color, as for drawPixel().
+    @note   Changes buffer contents only, no immediate effect on display.
+*/
+void Adafruit_GrayOLED::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                      uint16_t color) {
+  if (h > 0)
+    fillRect(x, y, 1, h, color);
+  else
+    Adafruit_GFX::drawFastVLine(x, y, h, color);
+}
+
+/*!
+    @brief  Fill a rectangle straight into the buffer, a page or a row at a
+            time, marking its dirty tiles once rather than per pixel.
+    @param  x
+            Leftmost column of rectangle.
+    @param  y
+            Topmost row of rectangle.
+    @param  w
+            Width of rectangle, in pixels.
+    @param  h
+            Height of rectangle, in pixels.
+    @param  color
+            Fill color, as for drawPixel().
+    @note   Changes buffer contents only, no immediate effect on display.
+*/
+void Adafruit_GrayOLED::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                 uint16_t color) {
+  if ((w < 1) || (h < 1)) { // Keep Adafruit_GFX's handling of odd sizes
+    Adafruit_GFX::fillRect(x, y, w, h, color);
+    return;
+  }
+  if (!buffer || !clipFillRect(x, y, w, h))
+    return;
+  rotateRect(x, y, w, h); // Buffer is in raw (rotation 0) order
+  markDirty(x, y, w, h);
+
+  if (_bpp == 1) {
+    for (int16_t y2 = y + h; y < y2;) { // One page (8 rows) at a time
+      uint8_t rows = min(8 - (y & 7), y2 - y);
+      uint8_t mask = ((1 << rows) - 1) << (y & 7);
+      uint8_t *ptr = &buffer[x + (y / 8) * WIDTH];
+      for (int16_t i = 0; i < w; i++) {
+        switch (color) {
+        case MONOOLED_WHITE:
+          ptr[i] |= mask;
+          break;
+        case MONOOLED_BLACK:
+          ptr[i] &= ~mask;
+          break;
+        case MONOOLED_INVERSE:
+          ptr[i] ^= mask;
+          break;
+        }
+      }
+      y += rows;
+    }
+  }
+  if (_bpp == 4) {
+    uint8_t c = color & 0xF;
+    for (int16_t y2 = y + h; y < y2; y++) {
+      uint8_t *row = &buffer[y * WIDTH / 2];
+      for (int16_t i = x; i < x + w; i++) {
+        if (i % 2 == 0) // even, left nibble
+          row[i / 2] = (row[i / 2] & 0x0F) | (c << 4);
+        else // odd, right lower nibble
+          row[i / 2] = (row[i / 2] & 0xF0) | c;
+      }
+    }
+  }
+}
+
 /*!
     @brief  Clear contents of display buffer (set all pixels to off).
     @note   Changes buffer contents only, no immediate effect on display.
@@ -348,6 +465,9 @@ void Adafruit_GrayOLED::clearDisplay(void) {
   window_y1 = 0;
   window_x2 = WIDTH - 1;
   window_y2 = HEIGHT - 1;
+  if (dirty_tiles)
+    memset(dirty_tiles, 0xFF,
+           (((WIDTH + 7) / 8) * ((HEIGHT + 7) / 8) + 7) / 8);
 }
 
 /*!
@@ -390,6 +510,86 @@ bool Adafruit_GrayOLED::getPixel(int16_t x, int16_t y) {
 */
 uint8_t *Adafruit_GrayOLED::getBuffer(void) { return buffer; }
 
+// DIRTY TRACKING ----------------------------------------------------------
+
+/*!
+    @brief  Mark an area of the buffer as changed, both in the dirty window
+            and in the 8x8 tile bitmap. For subclasses writing the buffer
+            directly.
+    @param  x
+            Leftmost column, in raw (rotation 0) coordinates.
+    @param  y
+            Topmost row, in raw coordinates.
+    @param  w
+            Width in pixels, area must be within the display.
+    @param  h
+            Height in pixels, area must be within the display.
+*/
+void Adafruit_GrayOLED::markDirty(int16_t x, int16_t y, int16_t w,
+                                  int16_t h) {
+  if ((w < 1) || (h < 1))
+    return;
+  int16_t x2 = x + w - 1, y2 = y + h - 1;
+  window_x1 = min(window_x1, x);
+  window_y1 = min(window_y1, y);
+  window_x2 = max(window_x2, x2);
+  window_y2 = max(window_y2, y2);
+  if (dirty_tiles) {
+    uint16_t cols = (WIDTH + 7) / 8;
+    for (int16_t ty = y / 8; ty <= y2 / 8; ty++) {
+      for (int16_t tx = x / 8; tx <= x2 / 8; tx++) {
+        uint16_t t = ty * cols + tx;
+        dirty_tiles[t / 8] |= 1 << (t & 7);
+      }
+    }
+  }
+}
+
+/*!
+    @brief  Get the next changed area of the buffer for display() to send,
+            and mark it clean. Areas are runs of dirty 8x8 tiles along one
+            band of 8 rows (one page for 1-bit displays), so two small
+            changes far apart don't mean sending everything between them.
+            Call until it returns false, sending each area in turn; that
+            also resets the dirty window.
+    @param  x
+            Leftmost column of area, in raw (rotation 0) coordinates.
+    @param  y
+            Topmost row of area, a multiple of 8.
+    @param  w
+            Width of area in pixels.
+    @param  h
+            Height of area in pixels, 8 except at a ragged bottom edge.
+    @return true if an area was returned, false if nothing is left to send.
+*/
+bool Adafruit_GrayOLED::nextDirtyTiles(int16_t *x, int16_t *y, int16_t *w,
+                                       int16_t *h) {
+  if (dirty_tiles) {
+    uint16_t cols = (WIDTH + 7) / 8, tiles = cols * ((HEIGHT + 7) / 8);
+    for (uint16_t t = 0; t < tiles; t++) {
+      if (!(t & 7) && !dirty_tiles[t / 8]) {
+        t += 7; // Skip 8 clean tiles at once
+      } else if (dirty_tiles[t / 8] & (1 << (t & 7))) {
+        uint16_t tx = t % cols, ty = t / cols, n = 0;
+        do { // Extend run along the band, cleaning as we go
+          dirty_tiles[t / 8] &= ~(1 << (t & 7));
+          t++;
+          n++;
+        } while ((tx + n < cols) && (dirty_tiles[t / 8] & (1 << (t & 7))));
+        *x = tx * 8;
+        *y = ty * 8;
+        *w = min((int16_t)(n * 8), (int16_t)(WIDTH - *x));
+        *h = min((int16_t)8, (int16_t)(HEIGHT - *y));
+        return true;
+      }
+    }
+  }
+  // Nothing left, empty the dirty window too
+  window_x1 = window_y1 = 0x7FFF;
+  window_x2 = window_y2 = -1;
+  return false;
+}
+
 // OTHER HARDWARE SETTINGS -------------------------------------------------
 
 /*!
@@ -68,6 +68,9 @@ public:
   void invertDisplay(bool i);
   void setContrast(uint8_t contrastlevel);
   void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
   bool getPixel(int16_t x, int16_t y);
   uint8_t *getBuffer(void);
 
@@ -76,6 +79,8 @@ public:
 
 protected:
   bool _init(uint8_t i2caddr = 0x3C, bool reset = true);
+  void markDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+  bool nextDirtyTiles(int16_t *x, int16_t *y, int16_t *w, int16_t *h);
 
   Adafruit_SPIDevice *spi_dev = NULL; ///< The SPI interface BusIO device
   Adafruit_I2CDevice *i2c_dev = NULL; ///< The I2C interface BusIO device
@@ -88,6 +93,8 @@ protected:
       window_x2,     ///< Dirty tracking window maximum x
       window_y2;     ///< Dirty tracking window maximum y
 
+  uint8_t *dirty_tiles = NULL; ///< Bitmap of changed 8x8 tiles, raw order
+
   int dcPin,  ///< The Arduino pin connected to D/C (for SPI)
       csPin,  ///< The Arduino pin connected to CS (for SPI)
       rstPin; ///< The Arduino pin connected to reset (-1 if unused)
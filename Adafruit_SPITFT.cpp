@@ -68,9 +68,10 @@
 #define tcNum 2              // Timer/Counter for parallel write strobe PWM
 #define wrPeripheral PIO_CCL // Use CCL to invert write strobe
 
-// DMA transfer-in-progress indicator and callback
+// DMA transfer-in-progress indicator, and display whose queuePixels()
+// job is running (if any), for Adafruit_SPITFT::dmaCallback()
 static volatile bool dma_busy = false;
-static void dma_callback(Adafruit_ZeroDMA *dma) { dma_busy = false; }
+static Adafruit_SPITFT *volatile dma_queue = NULL;
 
 #if defined(__SAMD51__)
 // Timer/counter info by index #
@@ -512,6 +513,25 @@ Adafruit_SPITFT::Adafruit_SPITFT(uint16_t w, uint16_t h, tftBusWidth busWidth,
 
 // end constructors -------
 
+/*!
+    @brief  Adafruit_SPITFT destructor. Frees the setPixelBatching() run
+            buffer and, on nRF52840 and RT-Thread, initSPI()'s writeColor()
+            buffer.
+*/
+Adafruit_SPITFT::~Adafruit_SPITFT() {
+  free(runColors);
+#if (defined(ARDUINO_NRF52_ADAFRUIT) && defined(NRF52840_XXAA)) ||            \
+    defined(ARDUINO_ARCH_RTTHREAD)
+  if (fillBuf) {
+#if defined(ARDUINO_ARCH_RTTHREAD)
+    rt_free(fillBuf);
+#else
+    rtos_free(fillBuf);
+#endif
+  }
+#endif
+}
+
 // CLASS MEMBER FUNCTIONS --------------------------------------------------
 
 // begin() and setAddrWindow() MUST be declared by any subclass.
@@ -657,6 +677,29 @@ void Adafruit_SPITFT::initSPI(uint32_t freq, uint8_t spiMode) {
     digitalWrite(_rst, HIGH);
     delay(200);
   }
+  resetAddrWindow(); // Display's window is unknown after init or reset
+
+#if (defined(ARDUINO_NRF52_ADAFRUIT) && defined(NRF52840_XXAA)) ||            \
+    defined(ARDUINO_ARCH_RTTHREAD)
+  // Allocate writeColor()'s fill buffer once here, rather than on every
+  // fill. If memory is tight, settle for a smaller one; failing that,
+  // writeColor() uses a few pixels on the stack.
+  if (!fillBuf) {
+    uint32_t len = SPITFT_FILL_PIXELS;
+    if (!len) // Default is 2 scanlines on the display's major axis
+      len = 2 * ((WIDTH > HEIGHT) ? WIDTH : HEIGHT);
+    for (; !fillBuf && (len > 16); len /= 2) {
+#if defined(ARDUINO_ARCH_RTTHREAD)
+      fillBuf = (uint16_t *)rt_malloc(2 * len);
+#else
+      fillBuf = (uint16_t *)rtos_malloc(2 * len);
+#endif
+      if (fillBuf)
+        fillBufLen = len;
+    }
+    fillBufCount = 0;
+  }
+#endif
 
 #if defined(USE_SPI_DMA) && (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
   if (((connection == TFT_HARD_SPI) || (connection == TFT_PARALLEL)) &&
@@ -884,7 +927,7 @@ void Adafruit_SPITFT::initSPI(uint32_t freq, uint8_t spiMode) {
 
           lastFillColor = 0x0000;
           lastFillLen = 0;
-          dma.setCallback(dma_callback);
+          dma.setCallback(dmaCallback);
           return; // Success!
                   // else clean up any partial allocation...
         } // end descriptor memalign()
@@ -931,6 +974,7 @@ void Adafruit_SPITFT::startWrite(void) {
             for all display types; not an SPI-specific function.
 */
 void Adafruit_SPITFT::endWrite(void) {
+  flushPixels();
   if (_cs >= 0)
     SPI_CS_HIGH();
   SPI_END_TRANSACTION();
@@ -944,6 +988,47 @@ void Adafruit_SPITFT::endWrite(void) {
 // rendering might make repeated lines or rects) before ending the
 // transaction. It's more efficient than starting a transaction every time.
 
+/*!
+    @brief  Set the address window of a display using MIPI DCS-style column
+            and row address commands (each taking 16-bit start and end
+            values), skipping the column or row command if its range is
+            unchanged since the last call. Runs of pixels along a row, as
+            from text or lines, then cost only the row (or column) command.
+            Meant for subclasses' setAddrWindow(); offsets by _xstart and
+            _ystart. Not self-contained; should follow a startWrite() call.
+            Pixels held by setPixelBatching() are flushed before the last
+            window is compared, since sending them sets a window of their
+            own. Anything else that changes the display's window behind
+            this function's back must call resetAddrWindow().
+    @param  x       Leftmost pixel of area (within display bounds).
+    @param  y       Topmost pixel of area (within display bounds).
+    @param  w       Width of area in pixels (>0).
+    @param  h       Height of area in pixels (>0).
+    @param  colCmd  Column address set command.
+    @param  rowCmd  Row address set command.
+    @param  ramCmd  Memory write command, always sent.
+*/
+void Adafruit_SPITFT::writeAddrWindow(uint16_t x, uint16_t y, uint16_t w,
+                                      uint16_t h, uint8_t colCmd,
+                                      uint8_t rowCmd, uint8_t ramCmd) {
+  flushPixels(); // Held run's window must be sent (and cached) first
+  uint16_t x0 = x + _xstart, x1 = x0 + w - 1;
+  uint16_t y0 = y + _ystart, y1 = y0 + h - 1;
+  if ((x0 != _winX0) || (x1 != _winX1)) {
+    writeCommand(colCmd);
+    SPI_WRITE32(((uint32_t)x0 << 16) | x1);
+    _winX0 = x0;
+    _winX1 = x1;
+  }
+  if ((y0 != _winY0) || (y1 != _winY1)) {
+    writeCommand(rowCmd);
+    SPI_WRITE32(((uint32_t)y0 << 16) | y1);
+    _winY0 = y0;
+    _winY1 = y1;
+  }
+  writeCommand(ramCmd);
+}
+
 /*!
     @brief  Draw a single pixel to the display at requested coordinates.
             Not self-contained; should follow a startWrite() call.
@@ -952,12 +1037,76 @@ void Adafruit_SPITFT::endWrite(void) {
     @param  color  16-bit pixel color in '565' RGB format.
 */
 void Adafruit_SPITFT::writePixel(int16_t x, int16_t y, uint16_t color) {
-  if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height)) {
+  if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height) &&
+      inClip(x, y)) {
+    if (runColors) { // Batching, see setPixelBatching()
+      // Extend the run if this is the next pixel along it. The second
+      // pixel decides whether it runs along a row or down a column.
+      if (runLen && (runLen < SPITFT_RUN_PIXELS) &&
+          (((x == runX + runLen) && (y == runY) &&
+            ((runLen == 1) || !runVertical)) ||
+           ((x == runX) && (y == runY + runLen) &&
+            ((runLen == 1) || runVertical)))) {
+        runVertical = (x == runX);
+        runColors[runLen++] = color;
+        return;
+      }
+      flushPixels();
+      runX = x;
+      runY = y;
+      runColors[0] = color;
+      runLen = 1;
+      return;
+    }
     setAddrWindow(x, y, 1, 1);
     SPI_WRITE16(color);
   }
 }
 
+/*!
+    @brief  Turn writePixel() batching on or off. When on, writePixel()
+            holds pixels back, and consecutive ones that are adjacent
+            along a row or down a column go out together in a single
+            address window. That saves most of the per-pixel window setup
+            for diagonal lines, circles and unscaled text. Held pixels are
+            sent by flushPixels(), which endWrite(), writeCommand() and
+            sendCommand() call, so anything drawn afterward still lands on
+            top. Code that sends pixel data any other way after
+            writePixel() should call flushPixels() first.
+    @param  enable  true to batch (allocates a small buffer), false to
+                    send each pixel as it's written (frees it).
+    @return true if batching is now on, false if off or the buffer
+            couldn't be allocated.
+*/
+bool Adafruit_SPITFT::setPixelBatching(bool enable) {
+  if (enable) {
+    if (!runColors)
+      runColors = (uint16_t *)malloc(SPITFT_RUN_PIXELS * sizeof(uint16_t));
+  } else if (runColors) {
+    flushPixels();
+    free(runColors);
+    runColors = NULL;
+  }
+  return runColors != NULL;
+}
+
+/*!
+    @brief  Send any pixels held back by writePixel() batching, as one
+            address window and writePixels() transfer. Not self-contained;
+            should follow a startWrite() call (as the held pixels did).
+*/
+void Adafruit_SPITFT::flushPixels(void) {
+  if (runLen) {
+    uint8_t len = runLen;
+    runLen = 0; // First, as setAddrWindow() calls back in here
+    if (runVertical)
+      setAddrWindow(runX, runY, 1, len);
+    else
+      setAddrWindow(runX, runY, len, 1);
+    writePixels(runColors, len);
+  }
+}
+
 /*!
     @brief  Swap bytes in an array of pixels; converts little-to-big or
             big-to-little endian. Used by writePixels() below in some
@@ -1020,16 +1169,49 @@ void Adafruit_SPITFT::writePixels(uint16_t *colors, uint32_t len, bool block,
     }
     return;
   }
-#elif defined(ARDUINO_NRF52_ADAFRUIT) &&                                       \
-    defined(NRF52840_XXAA) // Adafruit nRF52 use SPIM3 DMA at 32Mhz
-  if (!bigEndian) {
-    swapBytes(colors, len); // convert little-to-big endian for display
-  }
-  hwspi._spi->transfer(colors, NULL, 2 * len); // NULL RX to avoid overwrite
-  if (!bigEndian) {
-    swapBytes(colors, len); // big-to-little endian to restore pixel buffer
+#elif (defined(ARDUINO_NRF52_ADAFRUIT) &&                                      \
+       defined(NRF52840_XXAA)) ||                                              \
+    defined(ARDUINO_ARCH_RTTHREAD) // nRF52840 SPIM3 DMA at 32Mhz, RT-Thread
+  // Little-endian colors are swapped a chunk at a time into a staging
+  // buffer (writeColor()'s fill buffer, else a few pixels on the stack)
+  // rather than in place and back again, so 'colors' is only read once
+  // and never modified. RT-Thread's transfer() is full duplex, leaving
+  // the bytes read back in the buffer, so there big-endian colors are
+  // staged (just copied) too.
+#if defined(ARDUINO_ARCH_RTTHREAD)
+  bool const stage = true;
+#else
+  bool const stage = !bigEndian;
+#endif
+  uint16_t quickpath_buffer[32];
+  uint16_t *pixbuf = colors;
+  uint32_t pixbufcount = len;
+  if (stage) {
+    if (fillBuf) {
+      pixbuf = fillBuf;
+      pixbufcount = fillBufLen;
+      fillBufCount = 0; // Fill color is about to be overwritten
+    } else {
+      pixbuf = quickpath_buffer;
+      pixbufcount = 32;
+    }
   }
 
+  while (len) {
+    uint32_t const count = min(len, pixbufcount);
+    if (!bigEndian) {
+      swapBytes(colors, count, pixbuf); // little-to-big endian for display
+    } else if (stage) {
+      memcpy(pixbuf, colors, 2 * count);
+    }
+#if defined(ARDUINO_ARCH_RTTHREAD)
+    hwspi._spi->transfer(pixbuf, 2 * count);
+#else
+    hwspi._spi->transfer(pixbuf, NULL, 2 * count); // NULL RX, no overwrite
+#endif
+    colors += count;
+    len -= count;
+  }
   return;
 #elif defined(ARDUINO_ARCH_RP2040)
   spi_inst_t *pi_spi = hwspi._spi == &SPI ? __SPI0_DEVICE : __SPI1_DEVICE;
@@ -1046,15 +1228,6 @@ void Adafruit_SPITFT::writePixels(uint16_t *colors, uint32_t len, bool block,
     spi_write_blocking(pi_spi, (uint8_t *)colors, len * 2);
   }
   return;
-#elif defined(ARDUINO_ARCH_RTTHREAD)
-  if (!bigEndian) {
-    swapBytes(colors, len); // convert little-to-big endian for display
-  }
-  hwspi._spi->transfer(colors, 2 * len);
-  if (!bigEndian) {
-    swapBytes(colors, len); // big-to-little endian to restore pixel buffer
-  }
-  return;
 #elif defined(USE_SPI_DMA) &&                                                  \
     (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
   if ((connection == TFT_HARD_SPI) || (connection == TFT_PARALLEL)) {
@@ -1172,7 +1345,8 @@ void Adafruit_SPITFT::writePixels(uint16_t *colors, uint32_t len, bool block,
     @brief  Wait for the last DMA transfer in a prior non-blocking
             writePixels() call to complete. This does nothing if DMA
             is not enabled, and is not needed if blocking writePixels()
-            was used (as is the default case).
+            was used (as is the default case). After a non-blocking
+            pushCanvas(), this also ends that function's transaction.
 */
 void Adafruit_SPITFT::dmaWait(void) {
 #if defined(USE_SPI_DMA) && (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
@@ -1186,9 +1360,84 @@ void Adafruit_SPITFT::dmaWait(void) {
     pinPeripheral(tft8._wr, PIO_OUTPUT); // Switch WR back to GPIO
   }
 #endif // end __SAMD51__ || ARDUINO_SAMD_ZERO
+  if (pushBusy) { // End transaction left open by pushCanvas()/queuePixels()
+    pushBusy = false;
+    endWrite();
+  }
 #endif
 }
 
+#if defined(USE_SPI_DMA) && (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
+/*!
+    @brief  Start the oldest job in the queuePixels() queue: set its
+            address window and issue its pixels as one chained-descriptor
+            DMA transfer. Called with DMA idle, either by queuePixels() or
+            by dmaCallback() as the previous job completes.
+*/
+void Adafruit_SPITFT::dmaNextJob(void) {
+  SPITFTjob &job = dmaQueue[dmaQueueTail];
+
+  // Previous transfer may have left peripheral in DMA state, see
+  // SAMD51/21 note in writeColor()
+  if (connection == TFT_HARD_SPI) {
+    hwspi._spi->setDataMode(hwspi._mode);
+  } else {
+    pinPeripheral(tft8._wr, PIO_OUTPUT); // Switch WR back to GPIO
+  }
+  setAddrWindow(job.x, job.y, job.w, job.h);
+
+  // Same descriptor chain as big-endian writePixels()
+  const uint16_t *colors = job.colors;
+  uint32_t len = (uint32_t)job.w * job.h;
+  int d, numDescriptors = (len + 32766) / 32767;
+  for (d = 0; d < numDescriptors; d++) {
+    int count = (len < 32767) ? len : 32767;
+    descriptor[d].SRCADDR.reg = (uint32_t)colors + count * 2;
+    descriptor[d].BTCTRL.bit.SRCINC = 1;
+    descriptor[d].BTCNT.reg = count * 2;
+    descriptor[d].DESCADDR.reg = (uint32_t)&descriptor[d + 1];
+    len -= count;
+    colors += count;
+  }
+  descriptor[d - 1].DESCADDR.reg = 0;
+  memcpy(dptr, &descriptor[0], sizeof(DmacDescriptor));
+#if defined(__SAMD51__)
+  if (connection == TFT_PARALLEL) {
+    // Switch WR pin to PWM or CCL
+    pinPeripheral(tft8._wr, wrPeripheral);
+  }
+#endif // end __SAMD51__
+
+  dmaDone = job.done;
+  dmaDoneArg = job.arg;
+  dmaQueueTail = (dmaQueueTail + 1) % SPITFT_QUEUE_JOBS;
+  dma_queue = this;
+  dma_busy = true;
+  dma.startJob();
+  if (connection == TFT_PARALLEL)
+    dma.trigger();
+}
+
+/*!
+    @brief  DMA completion interrupt. Clears the busy flag and, if the
+            transfer was a queuePixels() job, reports it done and starts
+            the next one.
+    @param  dma  DMA channel (unused, only one transfer runs at a time).
+*/
+void Adafruit_SPITFT::dmaCallback(Adafruit_ZeroDMA *dma) {
+  (void)dma;
+  dma_busy = false;
+  Adafruit_SPITFT *tft = dma_queue;
+  if (tft) {
+    dma_queue = NULL;
+    if (tft->dmaDone)
+      tft->dmaDone(tft->dmaDoneArg);
+    if (tft->dmaQueueTail != tft->dmaQueueHead)
+      tft->dmaNextJob();
+  }
+}
+#endif // end USE_SPI_DMA
+
 /*!
     @brief  Check if DMA transfer is active. Always returts false if DMA
             is not enabled.
@@ -1237,68 +1486,56 @@ void Adafruit_SPITFT::writeColor(uint16_t color, uint32_t len) {
     }
     return;
   }
-#elif defined(ARDUINO_NRF52_ADAFRUIT) &&                                       \
-    defined(NRF52840_XXAA) // Adafruit nRF52840 use SPIM3 DMA at 32Mhz
-  // at most 2 scan lines
-  uint32_t const pixbufcount = min(len, ((uint32_t)2 * width()));
-  uint16_t *pixbuf = (uint16_t *)rtos_malloc(2 * pixbufcount);
-
-  // use SPI3 DMA if we could allocate buffer, else fall back to writing each
-  // pixel loop below
-  if (pixbuf) {
-    uint16_t const swap_color = __builtin_bswap16(color);
+#elif (defined(ARDUINO_NRF52_ADAFRUIT) &&                                      \
+       defined(NRF52840_XXAA)) ||                                              \
+    defined(ARDUINO_ARCH_RTTHREAD) // nRF52840 SPIM3 DMA at 32Mhz, RT-Thread
+  // Issue from the fill buffer allocated in initSPI(), else from a few
+  // pixels on the stack if that couldn't be had. Colors are stored
+  // byte-swapped, so writePixels() needn't swap them on each pass.
+  uint16_t const swap_color = __builtin_bswap16(color);
+  uint16_t quickpath_buffer[16];
+  uint16_t *pixbuf = quickpath_buffer;
+  uint32_t pixbufcount = min(len, (uint32_t)16);
+
+#if defined(ARDUINO_ARCH_RTTHREAD)
+  if (fillBuf) {
+    pixbuf = fillBuf;
+    pixbufcount = min(len, fillBufLen);
+  }
 
-    // fill buffer with color
-    for (uint32_t i = 0; i < pixbufcount; i++) {
+  while (len) {
+    uint32_t const count = min(len, pixbufcount);
+    // Refill every pass: RT-Thread's transfer() is full duplex and
+    // leaves the bytes read back in the buffer
+    for (uint32_t i = 0; i < count; i++) {
       pixbuf[i] = swap_color;
     }
-
-    while (len) {
-      uint32_t const count = min(len, pixbufcount);
-      writePixels(pixbuf, count, true, true);
-      len -= count;
-    }
-
-    rtos_free(pixbuf);
-    return;
+    writePixels(pixbuf, count, true, true);
+    len -= count;
+  }
+#else
+  uint32_t filled = 0;
+  if (fillBuf) {
+    pixbuf = fillBuf;
+    pixbufcount = min(len, fillBufLen);
+    // Pixels left from a prior fill with the same color needn't be set
+    // (transfer() is TX-only here, the buffer isn't overwritten)
+    if (swap_color == fillBufColor)
+      filled = fillBufCount;
+    fillBufColor = swap_color;
+    fillBufCount = max(pixbufcount, filled);
+  }
+  for (uint32_t i = filled; i < pixbufcount; i++) {
+    pixbuf[i] = swap_color;
   }
-#elif defined(ARDUINO_ARCH_RTTHREAD)
-  uint16_t pixbufcount;
-  uint16_t *pixbuf;
-  int16_t lines = height() / 4;
-#define QUICKPATH_MAX_LEN 16
-  uint16_t quickpath_buffer[QUICKPATH_MAX_LEN];
-
-  do {
-    pixbufcount = min(len, (lines * width()));
-    if (pixbufcount > QUICKPATH_MAX_LEN) {
-      pixbuf = (uint16_t *)rt_malloc(2 * pixbufcount);
-    } else {
-      pixbuf = quickpath_buffer;
-    }
-    lines -= 2;
-  } while (!pixbuf && lines > 0);
-
-  if (pixbuf) {
-    uint16_t const swap_color = __builtin_bswap16(color);
 
-    while (len) {
-      uint16_t count = min(len, pixbufcount);
-      // fill buffer with color
-      for (uint16_t i = 0; i < count; i++) {
-        pixbuf[i] = swap_color;
-      }
-      // Don't need to swap color inside the function
-      // It has been done outside this function
-      writePixels(pixbuf, count, true, true);
-      len -= count;
-    }
-    if (pixbufcount > QUICKPATH_MAX_LEN) {
-      rt_free(pixbuf);
-    }
-#undef QUICKPATH_MAX_LEN
-    return;
+  while (len) {
+    uint32_t const count = min(len, pixbufcount);
+    writePixels(pixbuf, count, true, true);
+    len -= count;
   }
+#endif
+  return;
 #else // !ESP32
 #if defined(USE_SPI_DMA) && (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
   if (((connection == TFT_HARD_SPI) || (connection == TFT_PARALLEL)) &&
@@ -1543,6 +1780,9 @@ void Adafruit_SPITFT::writeColor(uint16_t color, uint32_t len) {
 */
 void Adafruit_SPITFT::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
                                     uint16_t color) {
+  if (_clipActive && !clipRect(x, y, w, h))
+    return; // Nothing within the clip rectangle
+
   if (w && h) {   // Nonzero width and height?
     if (w < 0) {  // If negative width...
       x += w + 1; //   Move X to left edge
@@ -1595,6 +1835,10 @@ void Adafruit_SPITFT::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
 */
 void inline Adafruit_SPITFT::writeFastHLine(int16_t x, int16_t y, int16_t w,
                                             uint16_t color) {
+  int16_t h = 1;
+  if (_clipActive && !clipRect(x, y, w, h))
+    return; // Nothing within the clip rectangle
+
   if ((y >= 0) && (y < _height) && w) { // Y on screen, nonzero width
     if (w < 0) {                        // If negative width...
       x += w + 1;                       //   Move X to left edge
@@ -1631,6 +1875,10 @@ void inline Adafruit_SPITFT::writeFastHLine(int16_t x, int16_t y, int16_t w,
 */
 void inline Adafruit_SPITFT::writeFastVLine(int16_t x, int16_t y, int16_t h,
                                             uint16_t color) {
+  int16_t w = 1;
+  if (_clipActive && !clipRect(x, y, w, h))
+    return; // Nothing within the clip rectangle
+
   if ((x >= 0) && (x < _width) && h) { // X on screen, nonzero height
     if (h < 0) {                       // If negative height...
       y += h + 1;                      //   Move Y to top edge
@@ -1699,7 +1947,8 @@ inline void Adafruit_SPITFT::writeFillRectPreclipped(int16_t x, int16_t y,
 */
 void Adafruit_SPITFT::drawPixel(int16_t x, int16_t y, uint16_t color) {
   // Clip first...
-  if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height)) {
+  if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height) &&
+      inClip(x, y)) {
     // THEN set up transaction (if needed) and draw...
     startWrite();
     setAddrWindow(x, y, 1, 1);
@@ -1729,6 +1978,9 @@ void Adafruit_SPITFT::drawPixel(int16_t x, int16_t y, uint16_t color) {
 */
 void Adafruit_SPITFT::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
                                uint16_t color) {
+  if (_clipActive && !clipRect(x, y, w, h))
+    return; // Nothing within the clip rectangle
+
   if (w && h) {   // Nonzero width and height?
     if (w < 0) {  // If negative width...
       x += w + 1; //   Move X to left edge
@@ -1787,6 +2039,10 @@ void Adafruit_SPITFT::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
 */
 void Adafruit_SPITFT::drawFastHLine(int16_t x, int16_t y, int16_t w,
                                     uint16_t color) {
+  int16_t h = 1;
+  if (_clipActive && !clipRect(x, y, w, h))
+    return; // Nothing within the clip rectangle
+
   if ((y >= 0) && (y < _height) && w) { // Y on screen, nonzero width
     if (w < 0) {                        // If negative width...
       x += w + 1;                       //   Move X to left edge
@@ -1828,6 +2084,10 @@ void Adafruit_SPITFT::drawFastHLine(int16_t x, int16_t y, int16_t w,
 */
 void Adafruit_SPITFT::drawFastVLine(int16_t x, int16_t y, int16_t h,
                                     uint16_t color) {
+  int16_t w = 1;
+  if (_clipActive && !clipRect(x, y, w, h))
+    return; // Nothing within the clip rectangle
+
   if ((x >= 0) && (x < _width) && h) { // X on screen, nonzero height
     if (h < 0) {                       // If negative height...
       y += h + 1;                      //   Move Y to top edge
@@ -1884,29 +2144,43 @@ void Adafruit_SPITFT::pushColor(uint16_t color) {
 void Adafruit_SPITFT::drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors,
                                     int16_t w, int16_t h) {
 
-  int16_t x2, y2;                 // Lower-right coord
-  if ((x >= _width) ||            // Off-edge right
-      (y >= _height) ||           // " top
-      ((x2 = (x + w - 1)) < 0) || // " left
-      ((y2 = (y + h - 1)) < 0))
+  int16_t cx1 = _width - 1, cy1 = _height - 1, // Clip bounds: display,
+      cx0 = 0, cy0 = 0;                        // within clip rectangle
+  if (_clipActive) {
+    if (_clip.x0 > cx0)
+      cx0 = _clip.x0;
+    if (_clip.y0 > cy0)
+      cy0 = _clip.y0;
+    if (_clip.x1 < cx1)
+      cx1 = _clip.x1;
+    if (_clip.y1 < cy1)
+      cy1 = _clip.y1;
+  }
+
+  int16_t x2, y2;                   // Lower-right coord
+  if ((cx0 > cx1) || (cy0 > cy1) || // Empty clip rectangle
+      (x > cx1) ||                  // Off-edge right
+      (y > cy1) ||                  // " top
+      ((x2 = (x + w - 1)) < cx0) || // " left
+      ((y2 = (y + h - 1)) < cy0))
     return; // " bottom
 
   int16_t bx1 = 0, by1 = 0, // Clipped top-left within bitmap
       saveW = w;            // Save original bitmap width value
-  if (x < 0) {              // Clip left
-    w += x;
-    bx1 = -x;
-    x = 0;
+  if (x < cx0) {            // Clip left
+    w -= cx0 - x;
+    bx1 = cx0 - x;
+    x = cx0;
   }
-  if (y < 0) { // Clip top
-    h += y;
-    by1 = -y;
-    y = 0;
+  if (y < cy0) { // Clip top
+    h -= cy0 - y;
+    by1 = cy0 - y;
+    y = cy0;
   }
-  if (x2 >= _width)
-    w = _width - x; // Clip right
-  if (y2 >= _height)
-    h = _height - y; // Clip bottom
+  if (x2 > cx1)
+    w = cx1 - x + 1; // Clip right
+  if (y2 > cy1)
+    h = cy1 - y + 1; // Clip bottom
 
   pcolors += by1 * saveW + bx1; // Offset bitmap ptr to clipped top-left
   startWrite();
@@ -1918,6 +2192,290 @@ void Adafruit_SPITFT::drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors,
   endWrite();
 }
 
+/*!
+    @brief  Push a 16-bit canvas to the display at the specified (x,y)
+            position, clipped to the display and clip rectangle. The
+            address window is set only once. An unrotated canvas that fits
+            the display's width is sent as one writePixels() transfer
+            straight from its buffer; with DMA on SAMD and bigEndian set,
+            that's a single chained-descriptor transfer with no per-row
+            byte swapping. With block false, this returns as soon as the
+            transfer is started so the next frame can be drawn meanwhile,
+            e.g. into a second canvas. Call dmaWait() (which also ends the
+            transaction) before touching the canvas or the display again.
+            Handles its own transaction.
+    @param  canvas     Canvas to push, at its own rotation.
+    @param  x          Top left corner horizontal coordinate.
+    @param  y          Top left corner vertical coordinate.
+    @param  block      If false and DMA is available, don't wait for the
+                       transfer to complete. Ignored if no DMA.
+    @param  bigEndian  If true, canvas pixels are already in the display's
+                       big-endian order (e.g. via GFXcanvas16::byteSwap()).
+                       Implied by a canvas made in big-endian mode.
+*/
+void Adafruit_SPITFT::pushCanvas(GFXcanvas16 &canvas, int16_t x, int16_t y,
+                                 bool block, bool bigEndian) {
+  int16_t sx = 0, sy = 0, w = canvas.width(), h = canvas.height();
+  if (!canvas.getBuffer() || !clipCanvas(x, y, canvas, sx, sy, w, h))
+    return;
+  dmaWait(); // Let any earlier non-blocking push finish first
+  startWrite();
+  setAddrWindow(x, y, w, h);
+  writeCanvas(canvas, sx, sy, w, h, block, bigEndian || canvas.isBigEndian());
+#if defined(USE_SPI_DMA) && (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
+  if (!block) {
+    pushBusy = true; // dmaWait() ends the transaction
+    return;
+  }
+#endif
+  endWrite();
+}
+
+/*!
+    @brief  Queue a rectangle of pixels for the display. With DMA on SAMD
+            this returns at once, and the DMA completion interrupt runs
+            queued jobs back to back, setting each one's address window,
+            so several dirty areas can go out per frame without waiting
+            on the bus. Elsewhere the job is sent before returning. Use
+            dmaBusy() to poll, or dmaWait() as a fence, which also ends
+            the transaction this keeps open; don't touch the display or
+            the queued buffers before then. Up to SPITFT_QUEUE_JOBS - 1
+            jobs may wait; past that this blocks until one finishes.
+            Pixels held by setPixelBatching() are sent first; queued
+            jobs set their window from the interrupt, see setAddrWindow().
+    @param  x       Top left corner horizontal coordinate.
+    @param  y       Top left corner vertical coordinate.
+    @param  w       Width of rectangle, which must be on the display.
+    @param  h       Height of rectangle, which must be on the display.
+    @param  colors  w*h pixels in the display's big-endian order, e.g. the
+                    buffer of a big-endian GFXcanvas16 the same size.
+    @param  done    Optional function called when this job has been sent.
+                    With DMA, this runs in interrupt context.
+    @param  arg     Argument passed to done.
+    @return  false if the rectangle isn't entirely on the display (nothing
+             is queued), else true.
+*/
+bool Adafruit_SPITFT::queuePixels(int16_t x, int16_t y, int16_t w, int16_t h,
+                                  const uint16_t *colors, void (*done)(void *),
+                                  void *arg) {
+  if (!colors || (x < 0) || (y < 0) || (w < 1) || (h < 1) ||
+      (x + w > _width) || (y + h > _height))
+    return false;
+#if defined(USE_SPI_DMA) && (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
+  if ((connection == TFT_HARD_SPI) || (connection == TFT_PARALLEL)) {
+    if (dma_queue != this)
+      dmaWait(); // Not chaining jobs, so let any other transfer finish
+    // Send held pixels here, not from the interrupt's setAddrWindow()
+    flushPixels();
+    uint8_t next = (dmaQueueHead + 1) % SPITFT_QUEUE_JOBS;
+    while (next == dmaQueueTail)
+      ; // Queue full, wait for a job to finish
+    SPITFTjob &job = dmaQueue[dmaQueueHead];
+    job.colors = colors;
+    job.done = done;
+    job.arg = arg;
+    job.x = x;
+    job.y = y;
+    job.w = w;
+    job.h = h;
+    dmaQueueHead = next;
+    if (!dma_busy) { // Idle, start it here, else dmaCallback() will
+      if (!pushBusy) {
+        startWrite();
+        pushBusy = true; // dmaWait() ends the transaction
+      }
+      dmaNextJob();
+    }
+    return true;
+  }
+#endif
+  startWrite();
+  setAddrWindow(x, y, w, h);
+  writePixels((uint16_t *)colors, (uint32_t)w * h, true, true);
+  endWrite();
+  if (done)
+    done(arg);
+  return true;
+}
+
+/*!
+    @brief  Issue an already-clipped area of a 16-bit canvas to the
+            current address window. Rows of an unrotated canvas are sent
+            straight from its buffer (as one transfer if the area spans
+            whole rows), rotated canvases through a small line buffer.
+            Not self-contained; should follow startWrite() and
+            setAddrWindow() calls.
+    @param  src        Canvas to copy from.
+    @param  sx         Top left corner horizontal coordinate within src.
+    @param  sy         Top left corner vertical coordinate within src.
+    @param  w          Width of area in pixels.
+    @param  h          Height of area in pixels.
+    @param  block      If false, the last transfer may be left running as
+                       with writePixels().
+    @param  bigEndian  If true, canvas pixels are in big-endian order.
+*/
+void Adafruit_SPITFT::writeCanvas(const GFXcanvas16 &src, int16_t sx,
+                                  int16_t sy, int16_t w, int16_t h, bool block,
+                                  bool bigEndian) {
+  uint16_t *buffer = src.getBuffer();
+  if (!buffer)
+    return;
+  if (src.getRotation() == 0) { // Rows are contiguous in buffer
+    int16_t sw = src.width();
+    if (w == sw) { // And so is the whole area
+      writePixels(&buffer[(int32_t)sy * sw], (uint32_t)w * h, block,
+                  bigEndian);
+    } else {
+      for (buffer += (int32_t)sy * sw + sx; h--; buffer += sw)
+        writePixels(buffer, w, h ? true : block, bigEndian);
+    }
+    return;
+  }
+
+  uint16_t pixels[SPITFT_LINE_PIXELS]; // Sent in small batches from here
+  uint8_t n = 0;
+  for (int16_t j = 0; j < h; j++) {
+    for (int16_t i = 0; i < w; i++) {
+      uint16_t c = src.getPixel(sx + i, sy + j);
+      if (bigEndian && !src.isBigEndian()) // Undo byteSwap() by user
+        c = __builtin_bswap16(c);
+      pixels[n++] = c;
+      if (n == SPITFT_LINE_PIXELS) {
+        writePixels(pixels, n);
+        n = 0;
+      }
+    }
+  }
+  if (n)
+    writePixels(pixels, n);
+}
+
+/*!
+    @brief  Copy an already-clipped area of a 16-bit canvas (see
+            Adafruit_GFX::drawCanvas()), streaming it into one address
+            window with writeCanvas(). Keyed (transparent) copies can't be
+            streamed and are drawn a pixel at a time instead. Transaction
+            is handled by the caller.
+    @param  x        Top left corner horizontal coordinate.
+    @param  y        Top left corner vertical coordinate.
+    @param  src      Canvas to copy from.
+    @param  sx       Top left corner horizontal coordinate within src.
+    @param  sy       Top left corner vertical coordinate within src.
+    @param  w        Width of area in pixels.
+    @param  h        Height of area in pixels.
+    @param  key      Color that is not drawn, if keyed.
+    @param  keyed    If true, pixels of the key color are transparent.
+*/
+void Adafruit_SPITFT::blitCanvas(int16_t x, int16_t y, const GFXcanvas16 &src,
+                                 int16_t sx, int16_t sy, int16_t w, int16_t h,
+                                 uint16_t key, bool keyed) {
+  if (keyed) {
+    Adafruit_GFX::blitCanvas(x, y, src, sx, sy, w, h, key, keyed);
+    return;
+  }
+  if (!src.getBuffer())
+    return;
+  setAddrWindow(x, y, w, h);
+  writeCanvas(src, sx, sy, w, h, true, src.isBigEndian());
+}
+
+/*!
+    @brief  Draw a string with a solid background, with any font, writing
+            each pixel of its bounding box exactly once (see
+            Adafruit_GFX::drawOpaqueText() for details). This version sets
+            the address window once for the whole box, then streams every
+            row of pixels straight into it.
+    @param  x      Starting x position, as with setCursor().
+    @param  y      Starting y position, as with setCursor() (the baseline,
+                   with custom fonts).
+    @param  str    Null-terminated string.
+    @param  color  16-bit text color in '565' RGB format.
+    @param  bg     16-bit background color in '565' RGB format.
+*/
+void Adafruit_SPITFT::drawOpaqueText(int16_t x, int16_t y, const char *str,
+                                     uint16_t color, uint16_t bg) {
+  uint16_t pixels[SPITFT_LINE_PIXELS]; // Sent in small batches from here
+  int16_t x1, y1, x2, y2, row, i, w;
+  uint8_t n = 0, *mask;
+
+  if (!opaqueTextBox(x, y, str, &x1, &y1, &x2, &y2))
+    return;
+  w = x2 - x1 + 1;
+  if (!(mask = (uint8_t *)malloc((w + 7) / 8)))
+    return;
+
+  startWrite();
+  setAddrWindow(x1, y1, w, y2 - y1 + 1);
+  for (row = y1; row <= y2; row++) {
+    opaqueTextRow(x, y, str, row, x1, w, mask);
+    for (i = 0; i < w; i++) {
+      pixels[n++] = (mask[i >> 3] & (0x80 >> (i & 7))) ? color : bg;
+      if (n == SPITFT_LINE_PIXELS) {
+        writePixels(pixels, n);
+        n = 0;
+      }
+    }
+  }
+  if (n)
+    writePixels(pixels, n);
+  endWrite();
+
+  free(mask);
+}
+
+/*!
+    @brief  Copy an already-clipped area of an 8-bit canvas (see
+            Adafruit_GFX::drawCanvas()), expanding values to colors
+            through a palette. The address window is set once for the whole
+            area and rows are expanded into a small line buffer that's
+            streamed into it, so an 8-bit canvas plus palette pushes nearly
+            as fast as a 16-bit canvas with half the framebuffer RAM.
+            Keyed (transparent) copies can't be streamed and are drawn a
+            pixel at a time instead. Transaction is handled by the caller.
+    @param  x        Top left corner horizontal coordinate.
+    @param  y        Top left corner vertical coordinate.
+    @param  src      Canvas to copy from.
+    @param  sx       Top left corner horizontal coordinate within src.
+    @param  sy       Top left corner vertical coordinate within src.
+    @param  w        Width of area in pixels.
+    @param  h        Height of area in pixels.
+    @param  palette  256 16-bit colors for each value, or NULL to send the
+                     8-bit values themselves.
+    @param  key      Source value that is not drawn, if keyed.
+    @param  keyed    If true, pixels of the key value are transparent.
+*/
+void Adafruit_SPITFT::blitCanvas(int16_t x, int16_t y, const GFXcanvas8 &src,
+                                 int16_t sx, int16_t sy, int16_t w, int16_t h,
+                                 const uint16_t *palette, uint8_t key,
+                                 bool keyed) {
+  if (keyed) {
+    Adafruit_GFX::blitCanvas(x, y, src, sx, sy, w, h, palette, key, keyed);
+    return;
+  }
+  uint16_t pixels[SPITFT_LINE_PIXELS]; // Sent in small batches from here
+  const uint8_t *buffer = src.getBuffer();
+  bool direct = (src.getRotation() == 0); // Rows are contiguous in buffer
+  uint8_t n = 0;
+  if (!buffer)
+    return;
+
+  setAddrWindow(x, y, w, h);
+  for (int16_t j = 0; j < h; j++) {
+    const uint8_t *row =
+        direct ? &buffer[(int32_t)(sy + j) * src.width() + sx] : NULL;
+    for (int16_t i = 0; i < w; i++) {
+      uint8_t v = direct ? row[i] : src.getPixel(sx + i, sy + j);
+      pixels[n++] = palette ? palette[v] : v;
+      if (n == SPITFT_LINE_PIXELS) {
+        writePixels(pixels, n);
+        n = 0;
+      }
+    }
+  }
+  if (n)
+    writePixels(pixels, n);
+}
+
 // -------------------------------------------------------------------------
 // Miscellaneous class member functions that don't draw anything.
 
@@ -1955,6 +2513,8 @@ data
 */
 void Adafruit_SPITFT::sendCommand(uint8_t commandByte, uint8_t *dataBytes,
                                   uint8_t numDataBytes) {
+  flushPixels();
+  resetAddrWindow(); // Command might change window or addressing
   SPI_BEGIN_TRANSACTION();
   if (_cs >= 0)
     SPI_CS_LOW();
@@ -1987,6 +2547,8 @@ void Adafruit_SPITFT::sendCommand(uint8_t commandByte, uint8_t *dataBytes,
  */
 void Adafruit_SPITFT::sendCommand(uint8_t commandByte, const uint8_t *dataBytes,
                                   uint8_t numDataBytes) {
+  flushPixels();
+  resetAddrWindow(); // Command might change window or addressing
   SPI_BEGIN_TRANSACTION();
   if (_cs >= 0)
     SPI_CS_LOW();
@@ -2023,6 +2585,8 @@ void Adafruit_SPITFT::sendCommand(uint8_t commandByte, const uint8_t *dataBytes,
 void Adafruit_SPITFT::sendCommand16(uint16_t commandWord,
                                     const uint8_t *dataBytes,
                                     uint8_t numDataBytes) {
+  flushPixels();
+  resetAddrWindow(); // Command might change window or addressing
   SPI_BEGIN_TRANSACTION();
   if (_cs >= 0)
     SPI_CS_LOW();
@@ -2206,6 +2770,7 @@ void Adafruit_SPITFT::spiWrite(uint8_t b) {
     @param  cmd  8-bit command to write.
 */
 void Adafruit_SPITFT::writeCommand(uint8_t cmd) {
+  flushPixels(); // Batched pixels go before anything that follows
   SPI_DC_LOW();
   spiWrite(cmd);
   SPI_DC_HIGH();
@@ -2305,6 +2870,7 @@ void Adafruit_SPITFT::write16(uint16_t w) {
     @param  cmd  16-bit command to write.
 */
 void Adafruit_SPITFT::writeCommand16(uint16_t cmd) {
+  flushPixels();
   SPI_DC_LOW();
   write16(cmd);
   SPI_DC_HIGH();
@@ -92,6 +92,47 @@ typedef volatile ADAGFX_PORT_t *PORTreg_t; ///< PORT register type
 #include <Adafruit_ZeroDMA.h>
 #endif
 
+// Pixels in the buffer writeColor() keeps for fills on nRF52840 and
+// RT-Thread, allocated once in initSPI(). 0 means 2 scanlines on the
+// display's major axis. Can be set with a compiler flag, and is halved
+// as needed if there's not enough free memory at that point.
+#if !defined(SPITFT_FILL_PIXELS)
+#define SPITFT_FILL_PIXELS 0 ///< writeColor() buffer size, 0 = automatic
+#endif
+
+#if !defined(SPITFT_RUN_PIXELS)
+#if defined(__AVR__)
+#define SPITFT_RUN_PIXELS 16 ///< Max pixels per setPixelBatching() run
+#else
+#define SPITFT_RUN_PIXELS 32 ///< Max pixels per setPixelBatching() run
+#endif
+#endif
+
+// Stack buffer for pixels that canvas copies and drawOpaqueText() build
+// up before each writePixels(). At most 255.
+#if !defined(SPITFT_LINE_PIXELS)
+#if defined(__AVR__)
+#define SPITFT_LINE_PIXELS 16 ///< Pixels per batch in canvas/text writes
+#else
+#define SPITFT_LINE_PIXELS 64 ///< Pixels per batch in canvas/text writes
+#endif
+#endif
+
+#if !defined(SPITFT_QUEUE_JOBS)
+#define SPITFT_QUEUE_JOBS 8 ///< queuePixels() queue size, one kept unused
+#endif
+
+/// A queuePixels() job: an address window and the pixels to fill it with
+typedef struct {
+  const uint16_t *colors; ///< Pixels in display (big-endian) order
+  void (*done)(void *);   ///< Called when job has been sent, or NULL
+  void *arg;              ///< Argument for done()
+  int16_t x;              ///< Address window left edge
+  int16_t y;              ///< Address window top edge
+  int16_t w;              ///< Address window width
+  int16_t h;              ///< Address window height
+} SPITFTjob;
+
 // This is kind of a kludge. Needed a way to disambiguate the software SPI
 // and parallel constructors via their argument lists. Originally tried a
 // bool as the first argument to the parallel constructor (specifying 8-bit
@@ -168,7 +209,7 @@ public:
 
   // DESTRUCTOR ----------------------------------------------------------
 
-  ~Adafruit_SPITFT(){};
+  ~Adafruit_SPITFT();
 
   // CLASS MEMBER FUNCTIONS ----------------------------------------------
 
@@ -191,6 +232,10 @@ public:
                  added to x, within display bounds at current rotation).
       @param  h  Height of area to be drawn, in pixels (MUST be >0 and,
                  added to x, within display bounds at current rotation).
+      @note   With DMA on SAMD, queuePixels() jobs call this from the DMA
+              completion interrupt, so it must be safe to run there: only
+              writeCommand()/SPI_WRITE* style output, no delays, no
+              allocation and no Serial.
   */
   virtual void setAddrWindow(uint16_t x, uint16_t y, uint16_t w,
                              uint16_t h) = 0;
@@ -226,6 +271,10 @@ public:
   // before ending the transaction. It's more efficient than starting a
   // transaction every time.
   void writePixel(int16_t x, int16_t y, uint16_t color);
+  // Opt-in: hold back writePixel() calls, sending adjacent ones as runs
+  // in one address window. Runs go out by endWrite() or the next command:
+  bool setPixelBatching(bool enable);
+  void flushPixels(void);
   void writePixels(uint16_t *colors, uint32_t len, bool block = true,
                    bool bigEndian = false);
   void writeColor(uint16_t color, uint32_t len);
@@ -264,6 +313,18 @@ public:
   using Adafruit_GFX::drawRGBBitmap; // Check base class first
   void drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors, int16_t w,
                      int16_t h);
+  // Push a whole canvas in one address window, without blocking (until
+  // dmaWait()) if DMA is available and block is false:
+  void pushCanvas(GFXcanvas16 &canvas, int16_t x = 0, int16_t y = 0,
+                  bool block = true, bool bigEndian = false);
+  // Queue big-endian pixel rectangles, run back to back by DMA interrupt
+  // if available. dmaWait() is the fence for the whole queue:
+  bool queuePixels(int16_t x, int16_t y, int16_t w, int16_t h,
+                   const uint16_t *colors, void (*done)(void *) = NULL,
+                   void *arg = NULL);
+
+  void drawOpaqueText(int16_t x, int16_t y, const char *str, uint16_t color,
+                      uint16_t bg);
 
   void invertDisplay(bool i);
   uint16_t color565(uint8_t r, uint8_t g, uint8_t b);
@@ -392,6 +453,33 @@ protected:
   inline void TFT_RD_HIGH(void);   // Parallel interface read high
   inline void TFT_RD_LOW(void);    // Parallel interface read low
 
+  // Canvas copies that can be streamed into one address window
+  using Adafruit_GFX::blitCanvas;
+  void blitCanvas(int16_t x, int16_t y, const GFXcanvas8 &src, int16_t sx,
+                  int16_t sy, int16_t w, int16_t h, const uint16_t *palette,
+                  uint8_t key, bool keyed);
+  void blitCanvas(int16_t x, int16_t y, const GFXcanvas16 &src, int16_t sx,
+                  int16_t sy, int16_t w, int16_t h, uint16_t key, bool keyed);
+  void writeCanvas(const GFXcanvas16 &src, int16_t sx, int16_t sy, int16_t w,
+                   int16_t h, bool block, bool bigEndian);
+
+  // For subclasses' setAddrWindow(): send only the column or row range
+  // that changed since last time (MIPI DCS-style displays, defaults are
+  // the usual CASET, RASET and RAMWR commands). Batched pixels are
+  // flushed before the cached window is read, see setPixelBatching().
+  void writeAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                       uint8_t colCmd = 0x2A, uint8_t rowCmd = 0x2B,
+                       uint8_t ramCmd = 0x2C);
+  /**********************************************************************/
+  /*!
+    @brief  Forget the address window last sent by writeAddrWindow(), so
+            the next call sends it in full. Call after issuing commands
+            that change the display's window or addressing other than via
+            sendCommand(), which does this itself.
+  */
+  /**********************************************************************/
+  void resetAddrWindow(void) { _winX0 = _winX1 = _winY0 = _winY1 = 0xFFFF; }
+
   // CLASS INSTANCE VARIABLES --------------------------------------------
 
   // Here be dragons! There's a big union of three structures here --
@@ -510,6 +598,22 @@ protected:
   uint16_t lastFillColor = 0;        ///< Last color used w/fill
   uint32_t lastFillLen = 0;          ///< # of pixels w/last fill
   uint8_t onePixelBuf;               ///< For hi==lo fill
+  bool pushBusy = false;             ///< Transaction open until dmaWait()
+
+  SPITFTjob dmaQueue[SPITFT_QUEUE_JOBS]; ///< queuePixels() jobs
+  volatile uint8_t dmaQueueHead = 0;     ///< Next dmaQueue slot to fill
+  volatile uint8_t dmaQueueTail = 0;     ///< Next dmaQueue job to start
+  void (*dmaDone)(void *) = NULL;        ///< Running job's done function
+  void *dmaDoneArg = NULL;               ///< Argument for dmaDone
+  void dmaNextJob(void);
+  static void dmaCallback(Adafruit_ZeroDMA *dma);
+#endif
+#if (defined(ARDUINO_NRF52_ADAFRUIT) && defined(NRF52840_XXAA)) ||            \
+    defined(ARDUINO_ARCH_RTTHREAD)
+  uint16_t *fillBuf = NULL;  ///< writeColor() buffer, byte-swapped colors
+  uint32_t fillBufLen = 0;   ///< Pixels allocated in fillBuf
+  uint32_t fillBufCount = 0; ///< Leading pixels of fillBuf set to fillBufColor
+  uint16_t fillBufColor = 0; ///< Byte-swapped color last used (nRF52840 only)
 #endif
 #if defined(USE_FAST_PINIO)
 #if defined(HAS_PORT_SET_CLR)
@@ -534,6 +638,17 @@ protected:
   uint8_t invertOnCommand = 0;  ///< Command to enable invert mode
   uint8_t invertOffCommand = 0; ///< Command to disable invert mode
 
+  uint16_t _winX0 = 0xFFFF; ///< First column last set by writeAddrWindow()
+  uint16_t _winX1 = 0xFFFF; ///< Last column last set by writeAddrWindow()
+  uint16_t _winY0 = 0xFFFF; ///< First row last set by writeAddrWindow()
+  uint16_t _winY1 = 0xFFFF; ///< Last row last set by writeAddrWindow()
+
+  uint16_t *runColors = NULL; ///< writePixel() run, NULL if not batching
+  int16_t runX = 0;           ///< Column of first pixel in run
+  int16_t runY = 0;           ///< Row of first pixel in run
+  uint8_t runLen = 0;         ///< Number of pixels in run
+  bool runVertical = false;   ///< If true, run is down a column, else a row
+
   uint32_t _freq = 0; ///< Dummy var to keep subclasses happy
 };
 
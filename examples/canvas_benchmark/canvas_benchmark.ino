@@ -0,0 +1,218 @@
+/***************************************************
+  Benchmark for the Adafruit_GFX drawing primitives, rendering into
+  GFXcanvas1, GFXcanvas8 and GFXcanvas16 offscreen buffers. No display
+  is required -- results are printed to the Serial console, so this can
+  be run on any board (or an Arduino core emulator) to catch regressions
+  in the rasterizers.
+
+  For each canvas type, size and rotation, every test is repeated until
+  at least BENCH_MICROS have elapsed. Reported values are the average
+  time per call (ns/op) and the number of on-canvas pixels touched per
+  second (pixels/s). Pixel counts are taken by running the same calls
+  on a counting Adafruit_GFX subclass, so they're exact regardless of
+  clipping or rotation.
+
+  Canvases that can't be allocated (e.g. large 16-bit canvases on small
+  AVR boards) are reported and skipped.
+
+  To run it on a desktop instead (e.g. to compare builds quickly), see
+  extras/host_benchmark: 'make' there builds this same sketch against a
+  minimal Arduino core shim. Host timings only mean anything relative to
+  each other.
+
+  Adafruit invests time and resources providing this open source code,
+  please support Adafruit and open-source hardware by purchasing
+  products from Adafruit!
+
+  BSD license, all text above must be included in any redistribution
+ ****************************************************/
+
+#include <Adafruit_GFX.h>
+#include <Fonts/FreeSans9pt7b.h>
+
+#define BENCH_MICROS 100000UL // Minimum run time per test, microseconds
+
+// Canvas sizes to test (width, height at rotation 0)
+const int16_t sizes[][2] = {{64, 32}, {128, 64}, {240, 135}, {320, 240}};
+#define NUM_SIZES (sizeof sizes / sizeof sizes[0])
+
+// Square test images for the bitmap tests, smaller on AVR to fit in RAM
+#if defined(__AVR__)
+#define BMP_SIZE 16
+#else
+#define BMP_SIZE 32
+#endif
+uint8_t bitmap1[BMP_SIZE * BMP_SIZE / 8];
+uint16_t bitmap16[BMP_SIZE * BMP_SIZE];
+
+// An Adafruit_GFX subclass that draws nothing, only counts the pixels
+// that would land on the canvas. Since it has no optimized overrides,
+// every primitive is decomposed all the way down to drawPixel().
+class PixelCounter : public Adafruit_GFX {
+public:
+  PixelCounter(int16_t w, int16_t h) : Adafruit_GFX(w, h), count(0) {}
+  void drawPixel(int16_t x, int16_t y, uint16_t color) {
+    (void)color;
+    if ((x >= 0) && (y >= 0) && (x < _width) && (y < _height))
+      count++;
+  }
+  uint32_t count;
+};
+
+// Each test draws one "op" to the canvas. The iteration number i
+// is passed in so tests can vary their parameters from call to call.
+typedef void (*BenchFunc)(Adafruit_GFX &gfx, uint16_t i);
+
+void benchFillScreen(Adafruit_GFX &gfx, uint16_t i) {
+  gfx.fillScreen((i & 1) ? 0xF81F : 0x07E0); // Hi & lo bytes differ
+}
+
+void benchDrawLine(Adafruit_GFX &gfx, uint16_t i) {
+  int16_t w = gfx.width(), h = gfx.height(), y = i % h;
+  gfx.drawLine(0, y, w - 1, h - 1 - y, i);
+}
+
+void benchFillTriangle(Adafruit_GFX &gfx, uint16_t i) {
+  int16_t w = gfx.width(), h = gfx.height(), x = i % (w / 2);
+  gfx.fillTriangle(x, 0, w - 1 - x, h / 2, w / 4, h - 1, i);
+}
+
+void benchFillCircle(Adafruit_GFX &gfx, uint16_t i) {
+  int16_t w = gfx.width(), h = gfx.height();
+  gfx.fillCircle(w / 2, h / 2, min(w, h) / 4 + (i & 3), i);
+}
+
+void benchDrawEllipse(Adafruit_GFX &gfx, uint16_t i) {
+  int16_t w = gfx.width(), h = gfx.height();
+  gfx.drawEllipse(w / 2, h / 2, w / 3 + (i & 3), h / 3, i);
+}
+
+void benchDrawChar(Adafruit_GFX &gfx, uint16_t i) {
+  gfx.setFont();
+  gfx.setTextSize(1);
+  gfx.setTextColor(i);
+  gfx.setCursor(0, 0);
+  gfx.print(F("0123456789"));
+}
+
+void benchDrawCharBg(Adafruit_GFX &gfx, uint16_t i) {
+  gfx.setFont();
+  gfx.setTextSize(2);
+  gfx.setTextColor(i, ~i);
+  gfx.setCursor(0, 0);
+  gfx.print(F("12.34"));
+}
+
+void benchDrawGFXfont(Adafruit_GFX &gfx, uint16_t i) {
+  gfx.setFont(&FreeSans9pt7b);
+  gfx.setTextSize(1);
+  gfx.setTextColor(i);
+  gfx.setCursor(0, 14);
+  gfx.print(F("12.34 V"));
+  gfx.setFont();
+}
+
+void benchDrawBitmap(Adafruit_GFX &gfx, uint16_t i) {
+  int16_t x = i % (gfx.width() - BMP_SIZE / 2);
+  gfx.drawBitmap(x, 0, bitmap1, BMP_SIZE, BMP_SIZE, i, ~i);
+}
+
+void benchDrawRGBBitmap(Adafruit_GFX &gfx, uint16_t i) {
+  int16_t x = i % (gfx.width() - BMP_SIZE / 2);
+  gfx.drawRGBBitmap(x, 0, bitmap16, BMP_SIZE, BMP_SIZE);
+}
+
+struct BenchTest {
+  const char *name;
+  BenchFunc func;
+};
+
+const BenchTest tests[] = {
+    {"fillScreen", benchFillScreen},
+    {"drawLine", benchDrawLine},
+    {"fillTriangle", benchFillTriangle},
+    {"fillCircle", benchFillCircle},
+    {"drawEllipse", benchDrawEllipse},
+    {"print (classic)", benchDrawChar},
+    {"print (classic, bg)", benchDrawCharBg},
+    {"print (GFXfont)", benchDrawGFXfont},
+    {"drawBitmap", benchDrawBitmap},
+    {"drawRGBBitmap", benchDrawRGBBitmap},
+};
+#define NUM_TESTS (sizeof tests / sizeof tests[0])
+
+// Print a string padded with spaces to a fixed column width
+void printPadded(const char *str, uint8_t width) {
+  uint8_t len = strlen(str);
+  Serial.print(str);
+  while (len++ < width)
+    Serial.print(' ');
+}
+
+void runTests(Adafruit_GFX &gfx, const char *canvasName) {
+  char label[24];
+  for (uint8_t rotation = 0; rotation < 4; rotation++) {
+    gfx.setRotation(rotation);
+    PixelCounter counter(gfx.width(), gfx.height());
+    for (uint8_t t = 0; t < NUM_TESTS; t++) {
+      // Pixels per op, averaged over a few iterations
+      counter.count = 0;
+      for (uint16_t i = 0; i < 8; i++)
+        tests[t].func(counter, i);
+      float pixelsPerOp = counter.count / 8.0;
+
+      uint32_t ops = 0, elapsed, start = micros();
+      do {
+        tests[t].func(gfx, ops++);
+        yield();
+      } while ((elapsed = micros() - start) < BENCH_MICROS);
+
+      snprintf(label, sizeof label, "%s %dx%d r%d", canvasName,
+               gfx.width(), gfx.height(), rotation);
+      printPadded(label, 24);
+      printPadded(tests[t].name, 22);
+      Serial.print(elapsed * 1000.0 / ops, 1);
+      Serial.print(F(" ns/op  "));
+      Serial.print(pixelsPerOp * ops * 1000000.0 / elapsed, 0);
+      Serial.println(F(" pixels/s"));
+    }
+  }
+}
+
+// Allocate a canvas of the given type and size, run all tests on it
+template <class Canvas>
+void benchCanvas(const char *canvasName, int16_t w, int16_t h) {
+  Canvas canvas(w, h); // Buffer is malloc()ed, object itself is small
+  if (canvas.getBuffer()) {
+    runTests(canvas, canvasName);
+  } else {
+    Serial.print(canvasName);
+    Serial.print(' ');
+    Serial.print(w);
+    Serial.print('x');
+    Serial.print(h);
+    Serial.println(F(": not enough RAM, skipped"));
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10);
+
+  // Fill test images with arbitrary (but repeatable) patterns
+  for (uint16_t i = 0; i < sizeof bitmap1; i++)
+    bitmap1[i] = i * 37 + 11;
+  for (uint16_t i = 0; i < BMP_SIZE * BMP_SIZE; i++)
+    bitmap16[i] = i * 2654435761UL >> 16;
+
+  Serial.println(F("Adafruit_GFX canvas benchmark"));
+  for (uint8_t s = 0; s < NUM_SIZES; s++) {
+    benchCanvas<GFXcanvas1>("GFXcanvas1", sizes[s][0], sizes[s][1]);
+    benchCanvas<GFXcanvas8>("GFXcanvas8", sizes[s][0], sizes[s][1]);
+    benchCanvas<GFXcanvas16>("GFXcanvas16", sizes[s][0], sizes[s][1]);
+  }
+  Serial.println(F("Done!"));
+}
+
+void loop() {}
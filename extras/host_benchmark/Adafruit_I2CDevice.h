@@ -0,0 +1,2 @@
+// Adafruit_GFX.h includes this Adafruit_BusIO header, but only the
+// display drivers use it. Empty for the host benchmark build.
@@ -0,0 +1,68 @@
+// Just enough of the Arduino core to build Adafruit_GFX and the
+// canvas_benchmark sketch as a desktop program. NOT for use with the
+// Arduino IDE (which ignores the 'extras' folder anyway).
+
+#ifndef _HOST_ARDUINO_H_
+#define _HOST_ARDUINO_H_
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <time.h>
+
+#define PROGMEM // Flash is just memory here
+
+class __FlashStringHelper;
+#define F(string_literal) ((const __FlashStringHelper *)(string_literal))
+
+#ifndef min
+#define min(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+
+inline void yield(void) {}
+
+inline unsigned long micros(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long)ts.tv_sec * 1000000UL + ts.tv_nsec / 1000;
+}
+
+inline unsigned long millis(void) { return micros() / 1000; }
+
+inline void delay(unsigned long ms) {
+  unsigned long start = millis();
+  while (millis() - start < ms)
+    ;
+}
+
+/// Minimal Arduino String, only what Adafruit_GFX uses
+class String {
+public:
+  String(const char *str = "") : s(str) {}
+  unsigned int length(void) const { return s.length(); }
+  const char *c_str(void) const { return s.c_str(); }
+
+private:
+  std::string s;
+};
+
+#include "Print.h"
+
+/// Serial console is stdout
+class HardwareSerial : public Print {
+public:
+  void begin(unsigned long baud) { (void)baud; }
+  size_t write(uint8_t c) { return fwrite(&c, 1, 1, stdout); }
+  using Print::write;
+  operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif // _HOST_ARDUINO_H_
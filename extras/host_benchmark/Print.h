@@ -0,0 +1,72 @@
+// Minimal Arduino Print class for the host benchmark build, see Arduino.h
+
+#ifndef _HOST_PRINT_H_
+#define _HOST_PRINT_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define DEC 10
+#define HEX 16
+
+class __FlashStringHelper;
+
+/// Formats numbers and strings for a subclass's write(uint8_t)
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size) {
+    size_t n = 0;
+    while (size--)
+      n += write(*buffer++);
+    return n;
+  }
+  size_t write(const char *str) {
+    return write((const uint8_t *)str, strlen(str));
+  }
+
+  size_t print(const __FlashStringHelper *str) {
+    return write((const char *)str);
+  }
+  size_t print(const char *str) { return write(str); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(long n, int base = DEC) {
+    return printFormatted(base == HEX ? "%lX" : "%ld", n);
+  }
+  size_t print(unsigned long n, int base = DEC) {
+    return printFormatted(base == HEX ? "%lX" : "%lu", n);
+  }
+  size_t print(int n, int base = DEC) { return print((long)n, base); }
+  size_t print(unsigned int n, int base = DEC) {
+    return print((unsigned long)n, base);
+  }
+  size_t print(double n, int digits = 2) {
+    return printFormatted("%.*f", digits, n);
+  }
+
+  size_t println(void) { return write("\r\n"); }
+  template <typename T> size_t println(T value) {
+    size_t n = print(value);
+    return n + println();
+  }
+  template <typename T> size_t println(T value, int format) {
+    size_t n = print(value, format);
+    return n + println();
+  }
+
+private:
+  template <typename T> size_t printFormatted(const char *format, T value) {
+    char buf[32];
+    snprintf(buf, sizeof buf, format, value);
+    return write(buf);
+  }
+  size_t printFormatted(const char *format, int digits, double value) {
+    char buf[48];
+    snprintf(buf, sizeof buf, format, digits, value);
+    return write(buf);
+  }
+};
+
+#endif // _HOST_PRINT_H_
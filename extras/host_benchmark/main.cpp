@@ -0,0 +1,14 @@
+// Runs the canvas_benchmark sketch as a desktop program, to compare
+// rasterizer changes without a board. Timings are of course the host's,
+// not a microcontroller's: use them to compare builds, not hardware.
+
+#include "Arduino.h"
+
+HardwareSerial Serial;
+
+#include "../../examples/canvas_benchmark/canvas_benchmark.ino"
+
+int main(void) {
+  setup();
+  return 0;
+}
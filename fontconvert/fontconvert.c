@@ -8,6 +8,12 @@ fonts to be used with the Adafruit_GFX Arduino library.
 For UNIX-like systems.  Outputs to stdout; redirect to header file, e.g.:
   ./fontconvert ~/Library/Fonts/FreeSans.ttf 18 > FreeSans18pt7b.h
 
+Options before the filename produce a version 2 font (a GFXfont2, see
+gfxfont.h, passed to setFont() by reference rather than by address):
+  -k  include the font's kerning pairs
+  -r  run-length encode glyph bitmaps (smaller for large sizes)
+Fonts with over 64K of bitmaps get 32-bit offsets automatically.
+
 REQUIRES FREETYPE LIBRARY.  www.freetype.org
 
 Currently this only extracts the printable 7-bit ASCII chars of a font.
@@ -50,8 +56,29 @@ void enbit(uint8_t value) {
   }
 }
 
+// Output one run length (4-bit nibble) of an RLE glyph bitmap
+void ennibble(int n) {
+  for (int bit = 0x08; bit; bit >>= 1)
+    enbit(n & bit);
+}
+
+// Output a run of pixels for RLE glyph bitmaps, returns # of bits written.
+// Runs over 15 pixels are split by a zero-length run of the other color.
+int enrun(int run) {
+  int bits = 4;
+  while (run > 15) {
+    ennibble(15);
+    ennibble(0);
+    run -= 15;
+    bits += 8;
+  }
+  ennibble(run);
+  return bits;
+}
+
 int main(int argc, char *argv[]) {
   int i, j, err, size, first = ' ', last = '~', bitmapOffset = 0, x, y, byte;
+  int kerning = 0, rle = 0, wide, numKerns = 0, nbits, run, set, yAdvance, n;
   char *fontName, c, *ptr;
   FT_Library library;
   FT_Face face;
@@ -59,17 +86,33 @@ int main(int argc, char *argv[]) {
   FT_Bitmap *bitmap;
   FT_BitmapGlyphRec *g;
   GFXglyph *table;
+  uint32_t *offsets;
   uint8_t bit;
 
   // Parse command line.  Valid syntaxes are:
-  //   fontconvert [filename] [size]
-  //   fontconvert [filename] [size] [last char]
-  //   fontconvert [filename] [size] [first char] [last char]
+  //   fontconvert [options] [filename] [size]
+  //   fontconvert [options] [filename] [size] [last char]
+  //   fontconvert [options] [filename] [size] [first char] [last char]
   // Unless overridden, default first and last chars are
-  // ' ' (space) and '~', respectively
+  // ' ' (space) and '~', respectively. Options are -k (kerning)
+  // and -r (RLE bitmaps).
+
+  while ((argc > 1) && (argv[1][0] == '-')) {
+    if (!strcmp(argv[1], "-k")) {
+      kerning = 1;
+    } else if (!strcmp(argv[1], "-r")) {
+      rle = 1;
+    } else {
+      argc = 0; // Unknown option, show usage
+      break;
+    }
+    argv++;
+    argc--;
+  }
 
   if (argc < 3) {
-    fprintf(stderr, "Usage: %s fontfile size [first] [last]\n", argv[0]);
+    fprintf(stderr, "Usage: %s [-k] [-r] fontfile size [first] [last]\n",
+            argv[0]);
     return 1;
   }
 
@@ -96,7 +139,9 @@ int main(int argc, char *argv[]) {
 
   // Allocate space for font name and glyph table
   if ((!(fontName = malloc(strlen(ptr) + 20))) ||
-      (!(table = (GFXglyph *)malloc((last - first + 1) * sizeof(GFXglyph))))) {
+      (!(table = (GFXglyph *)malloc((last - first + 1) * sizeof(GFXglyph)))) ||
+      (!(offsets =
+             (uint32_t *)malloc((last - first + 1) * sizeof(uint32_t))))) {
     fprintf(stderr, "Malloc error\n");
     return 1;
   }
@@ -176,36 +221,88 @@ int main(int argc, char *argv[]) {
     // when needed.  16-bit offset means 64K max for bitmaps,
     // code currently doesn't check for overflow.  (Doesn't
     // check that size & offsets are within bounds either for
-    // that matter...please convert fonts responsibly.)
+    // that matter...please convert fonts responsibly.)  Bigger
+    // fonts get a table of 32-bit offsets, see below.
     table[j].bitmapOffset = bitmapOffset;
+    offsets[j] = bitmapOffset;
     table[j].width = bitmap->width;
     table[j].height = bitmap->rows;
     table[j].xAdvance = face->glyph->advance.x >> 6;
     table[j].xOffset = g->left;
     table[j].yOffset = 1 - g->top;
 
+    nbits = run = set = 0;
     for (y = 0; y < bitmap->rows; y++) {
       for (x = 0; x < bitmap->width; x++) {
         byte = x / 8;
         bit = 0x80 >> (x & 7);
-        enbit(bitmap->buffer[y * bitmap->pitch + byte] & bit);
+        if (!rle) {
+          enbit(bitmap->buffer[y * bitmap->pitch + byte] & bit);
+          nbits++;
+        } else if (!(bitmap->buffer[y * bitmap->pitch + byte] & bit) == !set) {
+          run++; // Same color as current run
+        } else {
+          nbits += enrun(run); // Color change, output run and start next
+          run = 1;
+          set = !set;
+        }
       }
     }
+    if (rle && bitmap->width && bitmap->rows)
+      nbits += enrun(run); // Last run
 
     // Pad end of char bitmap to next byte boundary if needed
-    int n = (bitmap->width * bitmap->rows) & 7;
-    if (n) {     // Pixel count not an even multiple of 8?
+    n = nbits & 7;
+    if (n) {     // Bit count not an even multiple of 8?
       n = 8 - n; // # bits to next multiple
       while (n--)
         enbit(0);
     }
-    bitmapOffset += (bitmap->width * bitmap->rows + 7) / 8;
+    bitmapOffset += (nbits + 7) / 8;
 
     FT_Done_Glyph(glyph);
   }
 
   printf(" };\n\n"); // End bitmap array
 
+  // Bitmaps beyond 64K need 32-bit offsets
+  wide = bitmapOffset > 0xFFFF;
+  if (wide) {
+    printf("const uint32_t %sOffsets[] PROGMEM = {\n  ", fontName);
+    for (j = 0; j <= last - first; j++) {
+      printf("%u", offsets[j]);
+      if (j < last - first)
+        printf((j % 8 == 7) ? ",\n  " : ", ");
+    }
+    printf(" };\n\n");
+  }
+
+  // Kerning pairs, sorted by left then right char as the library expects
+  if (kerning && FT_HAS_KERNING(face)) {
+    for (i = first; (i <= last) && (i < 256); i++) {
+      for (j = first; (j <= last) && (j < 256); j++) {
+        FT_Vector delta;
+        FT_Get_Kerning(face, FT_Get_Char_Index(face, i),
+                       FT_Get_Char_Index(face, j), FT_KERNING_DEFAULT, &delta);
+        int dx = delta.x >> 6;
+        if (!dx)
+          continue;
+        if (dx < -128)
+          dx = -128;
+        else if (dx > 127)
+          dx = 127;
+        if (!numKerns)
+          printf("const GFXkern %sKerns[] PROGMEM = {\n", fontName);
+        else
+          printf(",\n");
+        printf("  { 0x%02X, 0x%02X, %4d }", i, j, dx);
+        numKerns++;
+      }
+    }
+    if (numKerns)
+      printf(" };\n\n");
+  }
+
   // Output glyph attributes table (one per character)
   printf("const GFXglyph %sGlyphs[] PROGMEM = {\n", fontName);
   for (i = first, j = 0; i <= last; i++, j++) {
@@ -226,17 +323,35 @@ int main(int argc, char *argv[]) {
   printf("\n\n");
 
   // Output font structure
-  printf("const GFXfont %s PROGMEM = {\n", fontName);
-  printf("  (uint8_t  *)%sBitmaps,\n", fontName);
-  printf("  (GFXglyph *)%sGlyphs,\n", fontName);
   if (face->size->metrics.height == 0) {
     // No face height info, assume fixed width and get from a glyph.
-    printf("  0x%02X, 0x%02X, %d };\n\n", first, last, table[0].height);
+    yAdvance = table[0].height;
+  } else {
+    yAdvance = face->size->metrics.height >> 6;
+  }
+  n = bitmapOffset + (last - first + 1) * 7 + 7;
+  if (rle || numKerns || wide) { // Version 2 font wraps a GFXfont
+    printf("const GFXfont2 %s PROGMEM = {\n", fontName);
+    printf("  { (uint8_t  *)%sBitmaps,\n", fontName);
+    printf("    (GFXglyph *)%sGlyphs,\n", fontName);
+    printf("    0x%02X, 0x%02X, %d },\n", first, last, yAdvance);
+    printf("  %s, %d,\n", rle ? "GFXFONT_RLE" : "0", numKerns);
+    if (numKerns)
+      printf("  (GFXkern *)%sKerns,\n", fontName);
+    else
+      printf("  NULL,\n");
+    if (wide)
+      printf("  (uint32_t *)%sOffsets };\n\n", fontName);
+    else
+      printf("  NULL };\n\n");
+    n += 7 + numKerns * 3 + (wide ? (last - first + 1) * 4 : 0);
   } else {
-    printf("  0x%02X, 0x%02X, %ld };\n\n", first, last,
-           face->size->metrics.height >> 6);
+    printf("const GFXfont %s PROGMEM = {\n", fontName);
+    printf("  (uint8_t  *)%sBitmaps,\n", fontName);
+    printf("  (GFXglyph *)%sGlyphs,\n", fontName);
+    printf("  0x%02X, 0x%02X, %d };\n\n", first, last, yAdvance);
   }
-  printf("// Approx. %d bytes\n", bitmapOffset + (last - first + 1) * 7 + 7);
+  printf("// Approx. %d bytes\n", n);
   // Size estimate is based on AVR struct and pointer sizes;
   // actual size may vary.
 
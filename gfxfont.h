@@ -2,7 +2,8 @@
 // Example fonts are included in 'Fonts' directory.
 // To use a font in your Arduino sketch, #include the corresponding .h
 // file and pass address of GFXfont struct to setFont().  Pass NULL to
-// revert to 'classic' fixed-space bitmap font.
+// revert to 'classic' fixed-space bitmap font.  Version 2 (GFXfont2)
+// fonts are passed to setFont() by reference instead.
 
 #ifndef _GFXFONT_H_
 #define _GFXFONT_H_
@@ -17,6 +18,16 @@ typedef struct {
   int8_t yOffset;        ///< Y dist from cursor pos to UL corner
 } GFXglyph;
 
+/// Kerning adjustment for a PAIR of glyphs (version 2 fonts)
+typedef struct {
+  uint8_t left;  ///< First char of pair
+  uint8_t right; ///< Second char of pair
+  int8_t dx;     ///< Added to left char's xAdvance when followed by right
+} GFXkern;
+
+// Version 2 font flags
+#define GFXFONT_RLE 0x01 ///< Glyph bitmaps are run-length encoded
+
 /// Data stored for FONT AS A WHOLE
 typedef struct {
   uint8_t *bitmap;  ///< Glyph bitmaps, concatenated
@@ -26,4 +37,22 @@ typedef struct {
   uint8_t yAdvance; ///< Newline distance (y axis)
 } GFXfont;
 
+/// Version 2 font: a plain GFXfont plus kerning, 32-bit bitmap offsets
+/// and compressed bitmaps. Kept separate so GFXfont (and every font built
+/// for it) stays unchanged; pass the struct itself, not its address, to
+/// setFont() to use the extra data.
+///
+/// With GFXFONT_RLE, each glyph's bitmap (still starting on a byte
+/// boundary) is a series of 4-bit run lengths, high nibble first, giving
+/// the number of pixels (0-15) in alternating runs of clear and set pixels,
+/// in the usual left-to-right, top-to-bottom order, starting with clear.
+/// Longer runs are split with a zero-length run: 20 set is 15, 0, 5.
+typedef struct {
+  GFXfont font;       ///< Version 1 font data
+  uint8_t flags;      ///< GFXFONT_* flags
+  uint16_t kernCount; ///< Number of kerning pairs
+  GFXkern *kern;      ///< Kerning pairs sorted by left, then right
+  uint32_t *offset;   ///< If set, replaces glyph bitmapOffsets
+} GFXfont2;
+
 #endif // _GFXFONT_H_